@@ -1,35 +1,57 @@
-/** @file Timer.h
- * @brief Periodic Timer setup for TM4c123
- * @author Sijin Woo (https://github.com/SijWoo)
- */
-
-
-#ifndef TIMER_H
-#define TIMER_H
-
-#include <stdint.h>
-
-void SysTick_Init(uint32_t period);
-
-void Timer0A_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-void Timer0B_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-void Timer1A_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-void Timer1B_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-void Timer2A_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-void Timer2B_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-void Timer3A_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-void Timer3B_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-void Timer4A_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-void Timer4B_Init(void (*task)(void), uint32_t period, uint32_t priority);
-
-#endif
-
+/** @file Timer.h
+ * @brief Periodic Timer setup for TM4c123
+ * @author Sijin Woo (https://github.com/SijWoo)
+ */
+
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+
+// timer ids
+#define TIMER0A		0
+#define TIMER0B		1
+#define TIMER1A		2
+#define TIMER1B		3
+#define TIMER2A		4
+#define TIMER2B		5
+#define TIMER3A		6
+#define TIMER3B		7
+#define TIMER4A		8
+#define TIMER4B		9
+#define NUM_TIMERS	10
+
+void SysTick_Init(uint32_t period);
+
+void Timer_Init(uint32_t timer, void (*task)(void), uint32_t period, uint32_t priority);
+
+int32_t Timer_Alloc(void (*task)(void), uint32_t period, uint32_t priority);
+
+void Timer_Release(uint32_t timer);
+
+void Timer_Stop(uint32_t timer);
+
+void Timer_Start(uint32_t timer);
+
+void Timer_SetPeriod(uint32_t timer, uint32_t period);
+
+uint32_t Timer_GetPeriod(uint32_t timer);
+
+int32_t Timer_RescaleFits(uint32_t newClock);
+
+void Timer_Rescale(uint32_t newClock);
+
+// fixed timer inits
+#define Timer0A_Init(task, period, priority)	Timer_Init(TIMER0A, task, period, priority)
+#define Timer0B_Init(task, period, priority)	Timer_Init(TIMER0B, task, period, priority)
+#define Timer1A_Init(task, period, priority)	Timer_Init(TIMER1A, task, period, priority)
+#define Timer1B_Init(task, period, priority)	Timer_Init(TIMER1B, task, period, priority)
+#define Timer2A_Init(task, period, priority)	Timer_Init(TIMER2A, task, period, priority)
+#define Timer2B_Init(task, period, priority)	Timer_Init(TIMER2B, task, period, priority)
+#define Timer3A_Init(task, period, priority)	Timer_Init(TIMER3A, task, period, priority)
+#define Timer3B_Init(task, period, priority)	Timer_Init(TIMER3B, task, period, priority)
+#define Timer4A_Init(task, period, priority)	Timer_Init(TIMER4A, task, period, priority)
+#define Timer4B_Init(task, period, priority)	Timer_Init(TIMER4B, task, period, priority)
+
+#endif
@@ -1,304 +1,267 @@
-/** @file Timer.c
- * @brief Periodic Timer setup for TM4c123
- * @author Sijin Woo (https://github.com/SijWoo)
- */
-
-
-#include "Timer.h"
-#include "tm4c123gh6pm.h"
-
-void (*Task0A)(void);
-void (*Task0B)(void);
-void (*Task1A)(void);
-void (*Task1B)(void);
-void (*Task2A)(void);
-void (*Task2B)(void);
-void (*Task3A)(void);
-void (*Task3B)(void);
-void (*Task4A)(void);
-void (*Task4B)(void);
-
-void EnableInterrupts(void);
-void DisableInterrupts(void);
-uint32_t StartCritical(void);
-void EndCritical(uint32_t sr);
-
-
-/** SysTick_Init
- * Initialize Systick interrupt and values 
- * Make sure this is the second to lowest priority
- */
-void SysTick_Init(uint32_t period){
-	NVIC_ST_CTRL_R = 0;         // disable SysTick during setup
-	NVIC_ST_CURRENT_R = 0;      // any write to current clears it
-	NVIC_SYS_PRI3_R =(NVIC_SYS_PRI3_R&0x00FFFFFF)|0xD0000000; // priority 6
-	NVIC_SYS_PRI3_R =(NVIC_SYS_PRI3_R&0xFF00FFFF)|0x00E00000; // priority 7
-	NVIC_ST_RELOAD_R = period - 1; // reload value
-	NVIC_ST_CTRL_R = 0x00000007; // enable, core clock and interrupt arm
-}
-
-void Timer0A_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	uint32_t sr = StartCritical(); 
-	SYSCTL_RCGCTIMER_R |= 0x01;   // 0) activate TIMER0
-	Task0A = task;
-	TIMER0_CTL_R &= ~TIMER_CTL_TAEN;    // 1) disable TIMER0A during setup
-	TIMER0_CFG_R = TIMER_CFG_32_BIT_TIMER;    // 2) configure for 32-bit mode
-	TIMER0_TAMR_R = TIMER_TAMR_TAMR_PERIOD;   // 3) configure for periodic mode, default down-count settings
-	TIMER0_TAILR_R = period - 1;    // 4) reload value
-	TIMER0_TAPR_R = 0;            // 5) bus clock resolution
-	TIMER0_ICR_R = TIMER_ICR_TATOCINT;    // 6) clear TIMER0A timeout flag
-	TIMER0_IMR_R |= TIMER_IMR_TATOIM;    // 7) arm timeout interrupt
-	priority &= 0x07;
-	NVIC_PRI4_R = (NVIC_PRI4_R&0x00FFFFFF)|(priority << 29); // 8) priority 1
-	// interrupts enabled in the main program after all devices initialized
-	// vector number 35, interrupt number 19
-	NVIC_EN0_R |= 1<<19;           // 9) enable IRQ 19 in NVIC
-	TIMER0_CTL_R |= TIMER_CTL_TAEN;    // 10) enable TIMER0A
-	EndCritical(sr);
-}
-
-void Timer0B_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	uint32_t sr = StartCritical(); 
-	SYSCTL_RCGCTIMER_R |= 0x01;   // 0) activate TIMER0
-	Task0B = task;
-	TIMER0_CTL_R &= ~TIMER_CTL_TBEN;    // 1) disable TIMER0B during setup
-	TIMER0_CFG_R = TIMER_CFG_32_BIT_TIMER;    // 2) configure for 32-bit mode
-	TIMER0_TBMR_R = TIMER_TBMR_TBMR_PERIOD;   // 3) configure for periodic mode, default down-count settings
-	TIMER0_TBILR_R = period - 1;    // 4) reload value
-	TIMER0_TBPR_R = 0;            // 5) bus clock resolution
-	TIMER0_ICR_R = TIMER_ICR_TBTOCINT;    // 6) clear TIMER0B timeout flag
-	TIMER0_IMR_R |= TIMER_IMR_TBTOIM;    // 7) arm timeout interrupt
-	priority &= 0x07;
-	NVIC_PRI5_R = (NVIC_PRI5_R&0xFFFFFF00)|(priority << 5); // 8) priority 1
-	// interrupts enabled in the main program after all devices initialized
-	// vector number 36, interrupt number 20
-	NVIC_EN0_R |= 1<<20;           // 9) enable IRQ 20 in NVIC
-	TIMER0_CTL_R |= TIMER_CTL_TBEN;    // 10) enable TIMER0B
-	EndCritical(sr);
-}
-
-void Timer1A_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	uint32_t sr = StartCritical();
-	SYSCTL_RCGCTIMER_R |= 0x02;   // 0) activate TIMER1
-	Task1A = task;
-	TIMER1_CTL_R &= ~TIMER_CTL_TAEN;    // 1) disable TIMER1A during setup
-	TIMER1_CFG_R = TIMER_CFG_32_BIT_TIMER;    // 2) configure for 32-bit mode
-	TIMER1_TAMR_R = TIMER_TAMR_TAMR_PERIOD;   // 3) configure for periodic mode, default down-count settings
-	TIMER1_TAILR_R = period-1;    // 4) reload value
-	TIMER1_TAPR_R = 0;            // 5) bus clock resolution
-	TIMER1_ICR_R = TIMER_ICR_TATOCINT;    // 6) clear TIMER1A timeout flag
-	TIMER1_IMR_R |= TIMER_IMR_TATOIM;    // 7) arm timeout interrupt
-	priority = (priority & 0x07) << 13; // mask priority (nvic bits 15-13)
-	NVIC_PRI5_R = (NVIC_PRI5_R&0xFFFF00FF)| (priority); // 8) priority 
-	
-	// interrupts enabled in the main program after all devices initialized
-	// vector number 37, interrupt number 21
-	NVIC_EN0_R |= 1<<21;           // 9) enable IRQ 21 in NVIC
-	TIMER1_CTL_R |= TIMER_CTL_TAEN;    // 10) enable TIMER1A
-	EndCritical(sr);
-}
-
-void Timer1B_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	uint32_t sr = StartCritical();
-	SYSCTL_RCGCTIMER_R |= 0x02;   // 0) activate TIMER1
-	Task1B = task;
-	TIMER1_CTL_R &= ~TIMER_CTL_TBEN;    // 1) disable TIMER1B during setup
-	TIMER1_CFG_R = TIMER_CFG_32_BIT_TIMER;    // 2) configure for 32-bit mode
-	TIMER1_TBMR_R = TIMER_TBMR_TBMR_PERIOD;   // 3) configure for periodic mode, default down-count settings
-	TIMER1_TBILR_R = period-1;    // 4) reload value
-	TIMER1_TBPR_R = 0;            // 5) bus clock resolution
-	TIMER1_ICR_R = TIMER_ICR_TBTOCINT;    // 6) clear TIMER1B timeout flag
-	TIMER1_IMR_R |= TIMER_IMR_TBTOIM;    // 7) arm timeout interrupt
-	priority &= 0x07;
-	NVIC_PRI5_R = (NVIC_PRI5_R&0xFF00FFFF)| (priority << 21); // 8) priority 
-	
-	// interrupts enabled in the main program after all devices initialized
-	// vector number 38, interrupt number 22
-	NVIC_EN0_R |= 1<<22;           // 9) enable IRQ 22 in NVIC
-	TIMER1_CTL_R |= TIMER_CTL_TBEN;    // 10) enable TIMER1B
-	EndCritical(sr);
-}
-
-void Timer2A_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	SYSCTL_RCGCTIMER_R |= 0x04;   // 0) activate timer2
-  Task2A = task;          // user function
-  TIMER2_CTL_R &= ~TIMER_CTL_TAEN;    // 1) disable timer2A during setup
-  TIMER2_CFG_R = TIMER_CFG_32_BIT_TIMER;    // 2) configure for 32-bit mode
-  TIMER2_TAMR_R = TIMER_TAMR_TAMR_PERIOD;   // 3) configure for periodic mode, default down-count settings
-  TIMER2_TAILR_R = period-1;    // 4) reload value
-  TIMER2_TAPR_R = 0;            // 5) bus clock resolution
-  TIMER2_ICR_R = TIMER_ICR_TATOCINT;    // 6) clear timer2A timeout flag
-  TIMER2_IMR_R |= TIMER_IMR_TATOIM;    // 7) arm timeout interrupt
-	priority &= 0x07;
-  NVIC_PRI5_R = (NVIC_PRI5_R&0x00FFFFFF)|(priority << 29); // 8) priority
-// interrupts enabled in the main program after all devices initialized
-// vector number 39, interrupt number 23
-  NVIC_EN0_R |= 1<<23;           // 9) enable IRQ 23 in NVIC
-  TIMER2_CTL_R |= TIMER_CTL_TAEN;    // 10) enable timer2A
-}
-
-void Timer2B_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	SYSCTL_RCGCTIMER_R |= 0x04;   // 0) activate timer2
-  Task2B = task;          // user function
-  TIMER2_CTL_R &= ~TIMER_CTL_TBEN;    // 1) disable timer2B during setup
-  TIMER2_CFG_R = TIMER_CFG_32_BIT_TIMER;    // 2) configure for 32-bit mode
-  TIMER2_TBMR_R = TIMER_TBMR_TBMR_PERIOD;   // 3) configure for periodic mode, default down-count settings
-  TIMER2_TBILR_R = period-1;    // 4) reload value
-  TIMER2_TBPR_R = 0;            // 5) bus clock resolution
-  TIMER2_ICR_R = TIMER_ICR_TBTOCINT;    // 6) clear timer2B timeout flag
-  TIMER2_IMR_R |= TIMER_IMR_TBTOIM;    // 7) arm timeout interrupt
-	priority &= 0x07;
-  NVIC_PRI6_R = (NVIC_PRI6_R&0xFFFFFF00)|(priority << 5); // 8) priority
-// interrupts enabled in the main program after all devices initialized
-// vector number 40, interrupt number 24
-  NVIC_EN0_R |= 1<<24;           // 9) enable IRQ 24 in NVIC
-  TIMER2_CTL_R |= TIMER_CTL_TBEN;    // 10) enable timer2B
-}
-
-void Timer3A_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	uint32_t sr = StartCritical();
-	SYSCTL_RCGCTIMER_R |= 0x08;   // 0) activate TIMER3
-	Task3A = task;
-	TIMER3_CTL_R &= ~TIMER_CTL_TAEN;    // 1) disable TIMER3A during setup
-	TIMER3_CFG_R = TIMER_CFG_32_BIT_TIMER;    // 2) configure for 32-bit mode
-	TIMER3_TAMR_R = TIMER_TAMR_TAMR_PERIOD;   // 3) configure for periodic mode, default down-count settings
-	TIMER3_TAILR_R = period - 1;   // 4) reload value
-	TIMER3_TAPR_R = 0;            // 5) bus clock resolution
-	TIMER3_ICR_R = TIMER_ICR_TATOCINT;    // 6) clear TIMER3A timeout flag
-	TIMER3_IMR_R |= TIMER_IMR_TATOIM;    // 7) arm timeout interrupt
-	priority &= 0x07;
-	NVIC_PRI8_R = (NVIC_PRI8_R&0x00FFFFFF)|(priority << 29); // 8) priority
-	
-	#if JITTER
-	Timer3_Period = period;
-	#endif
-	
-	// interrupts enabled in the main program after all devices initialized
-	// vector number 51, interrupt number 35
-	NVIC_EN1_R |= 1<<(35-32);      // 9) enable IRQ 35 in NVIC
-	TIMER3_CTL_R |= TIMER_CTL_TAEN;    // 10) enable TIMER3A
-	EndCritical(sr);
-}
-
-void Timer3B_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	uint32_t sr = StartCritical();
-	SYSCTL_RCGCTIMER_R |= 0x08;   // 0) activate TIMER3
-	Task3B = task;
-	TIMER3_CTL_R &= ~TIMER_CTL_TBEN;    // 1) disable TIMER3B during setup
-	TIMER3_CFG_R = TIMER_CFG_32_BIT_TIMER;    // 2) configure for 32-bit mode
-	TIMER3_TBMR_R = TIMER_TBMR_TBMR_PERIOD;   // 3) configure for periodic mode, default down-count settings
-	TIMER3_TBILR_R = period - 1;   // 4) reload value
-	TIMER3_TBPR_R = 0;            // 5) bus clock resolution
-	TIMER3_ICR_R = TIMER_ICR_TBTOCINT;    // 6) clear TIMER3A timeout flag
-	TIMER3_IMR_R |= TIMER_IMR_TBTOIM;    // 7) arm timeout interrupt
-	priority &= 0x07;
-	NVIC_PRI9_R = (NVIC_PRI9_R&0xFFFFFF00)|(priority << 5); // 8) priority
-	
-	// interrupts enabled in the main program after all devices initialized
-	// vector number 52, interrupt number 36
-	NVIC_EN1_R |= 1<<(36-32);      // 9) enable IRQ 35 in NVIC
-	TIMER3_CTL_R |= TIMER_CTL_TBEN;    // 10) enable TIMER3B
-	EndCritical(sr);
-}
-
-void Timer4A_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	uint32_t sr = StartCritical();
-	SYSCTL_RCGCTIMER_R |= 0x10;   	// 0) activate TIMER4
-	Task4A = task;
-	TIMER4_CTL_R &= ~TIMER_CTL_TAEN;    	// 1) disable TIMER4A during setup
-	TIMER4_CFG_R = TIMER_CFG_32_BIT_TIMER;    	// 2) configure for 32-bit mode
-	TIMER4_TAMR_R = TIMER_TAMR_TAMR_PERIOD;   	// 3) configure for periodic mode, default down-count settings
-	TIMER4_TAILR_R = period - 1;    	// 4) reload value
-	TIMER4_TAPR_R = 0;            	// 5) bus clock resolution
-	TIMER4_ICR_R = TIMER_ICR_TATOCINT;    	// 6) clear TIMER4A timeout flag
-	TIMER4_IMR_R |= TIMER_IMR_TATOIM;    	// 7) arm timeout interrupt
-	priority &= 0x07;
-	
-	#if JITTER
-	Timer4_Period = period;
-	#endif
-	
-	NVIC_PRI17_R = (NVIC_PRI17_R&0xFF00FFFF);
-	NVIC_PRI17_R = (NVIC_PRI17_R | (priority << 21)); // 8) priority
-	// interrupts enabled in the main program after all devices initialized
-	// vector number 86, interrupt number 70
-	NVIC_EN2_R = 1<<(70-64);      // 9) enable IRQ 70 in NVIC 
-	TIMER4_CTL_R |= TIMER_CTL_TAEN;    // 10) enable TIMER4A
-	EndCritical(sr);
-}
-
-void Timer4B_Init(void (*task)(void), uint32_t period, uint32_t priority){
-	uint32_t sr = StartCritical();
-	SYSCTL_RCGCTIMER_R |= 0x10;   	// 0) activate TIMER4
-	Task4B = task;
-	TIMER4_CTL_R &= ~TIMER_CTL_TBEN;    	// 1) disable TIMER4B during setup
-	TIMER4_CFG_R = TIMER_CFG_32_BIT_TIMER;    	// 2) configure for 32-bit mode
-	TIMER4_TBMR_R = TIMER_TBMR_TBMR_PERIOD;   	// 3) configure for periodic mode, default down-count settings
-	TIMER4_TBILR_R = period - 1;    	// 4) reload value
-	TIMER4_TBPR_R = 0;            	// 5) bus clock resolution
-	TIMER4_ICR_R = TIMER_ICR_TBTOCINT;    	// 6) clear TIMER4B timeout flag
-	TIMER4_IMR_R |= TIMER_IMR_TBTOIM;    	// 7) arm timeout interrupt
-	priority &= 0x07;
-	NVIC_PRI17_R = (NVIC_PRI17_R&0x00FFFFFF);
-	NVIC_PRI17_R = (NVIC_PRI17_R | (priority << 29)); // 8) priority
-	// interrupts enabled in the main program after all devices initialized
-	// vector number 87, interrupt number 71
-	NVIC_EN2_R = 1<<(71-64);      // 9) enable IRQ 71 in NVIC 
-	TIMER4_CTL_R |= TIMER_CTL_TBEN;    // 10) enable TIMER4B
-	EndCritical(sr);
-}
-
-
-
-
-
-void Timer0A_Handler(void){
-	TIMER0_ICR_R = TIMER_ICR_TATOCINT;// acknowledge timer0A timeout
-	Task0A();
-}
-
-void Timer0B_Handler(void){
-	TIMER0_ICR_R = TIMER_ICR_TBTOCINT;// acknowledge timer0B timeout
-	Task0B();
-}
-
-void Timer1A_Handler(void){
-	TIMER1_ICR_R = TIMER_ICR_TATOCINT;// acknowledge timer1A timeout
-	Task1A();
-}
-
-void Timer1B_Handler(void){
-	TIMER1_ICR_R = TIMER_ICR_TBTOCINT;// acknowledge timer1B timeout
-	Task1B();
-}
-
-void Timer2A_Handler(void){
-	TIMER2_ICR_R = TIMER_ICR_TATOCINT;// acknowledge timer2A timeout
-	Task2A();
-}
-
-void Timer2B_Handler(void){
-	TIMER2_ICR_R = TIMER_ICR_TBTOCINT;// acknowledge timer2B timeout
-	Task2B();
-}
-
-void Timer3A_Handler(void){
-	TIMER3_ICR_R = TIMER_ICR_TATOCINT;// acknowledge timer3A timeout
-	Task3A();
-}
-
-void Timer3B_Handler(void){
-	TIMER3_ICR_R = TIMER_ICR_TBTOCINT;// acknowledge timer3B timeout
-	Task3B();
-}
-
-void Timer4A_Handler(void){
-	TIMER4_ICR_R = TIMER_ICR_TATOCINT;// acknowledge timer4A timeout
-	Task4A();
-}
-
-void Timer4B_Handler(void){
-	TIMER4_ICR_R = TIMER_ICR_TBTOCINT;// acknowledge timer4B timeout
-	Task4B();
-}
-
+/** @file Timer.c
+ * @brief Periodic Timer setup for TM4c123
+ * @author Sijin Woo (https://github.com/SijWoo)
+ *
+ * One descriptor per timer half (Timer0A-Timer4B) holds its register block,
+ * clock gate bit and IRQ number so a single init, stop and handler serve all ten.
+ * B half registers and bits are the A half ones shifted (+1 word / <<8).
+ */
+
+
+#include "Timer.h"
+#include "cpu.h"
+#include "tm4c123gh6pm.h"
+#include "startup.h"
+#include "OS.h"		// OS_CSPROFILE renames critical sections here too
+
+// word offsets of A half registers from timer base (CFG)
+#define TIMER_CFG		0
+#define TIMER_MR		1		// TAMR, TBMR at +1
+#define TIMER_CTL		3
+#define TIMER_IMR		6
+#define TIMER_ICR		9
+#define TIMER_ILR		10		// TAILR, TBILR at +1
+#define TIMER_PR		14		// TAPR, TBPR at +1
+#define TIMER_V			20		// TAV, TBV at +1
+
+/** TimerDesc
+ * Fixed hardware info of one timer half
+*/
+typedef struct{
+	volatile uint32_t *base;	// CFG register of timer block
+	uint8_t rcgc;				// bit in SYSCTL_RCGCTIMER_R
+	uint8_t irq;				// interrupt number
+	uint8_t half;				// 0: A, 1: B
+} TimerDesc;
+
+static const TimerDesc Timers[NUM_TIMERS] = {
+	{&TIMER0_CFG_R, 0x01, 19, 0},	// TIMER0A, vector 35
+	{&TIMER0_CFG_R, 0x01, 20, 1},	// TIMER0B, vector 36
+	{&TIMER1_CFG_R, 0x02, 21, 0},	// TIMER1A, vector 37
+	{&TIMER1_CFG_R, 0x02, 22, 1},	// TIMER1B, vector 38
+	{&TIMER2_CFG_R, 0x04, 23, 0},	// TIMER2A, vector 39
+	{&TIMER2_CFG_R, 0x04, 24, 1},	// TIMER2B, vector 40
+	{&TIMER3_CFG_R, 0x08, 35, 0},	// TIMER3A, vector 51
+	{&TIMER3_CFG_R, 0x08, 36, 1},	// TIMER3B, vector 52
+	{&TIMER4_CFG_R, 0x10, 70, 0},	// TIMER4A, vector 86
+	{&TIMER4_CFG_R, 0x10, 71, 1},	// TIMER4B, vector 87
+};
+
+static void (*Tasks[NUM_TIMERS])(void);
+static uint32_t Periods[NUM_TIMERS];		// reload now, bus cycles of TimerClock
+static uint32_t Requested[NUM_TIMERS];		// period as asked for, bus cycles of RequestClock
+static uint32_t RequestClock[NUM_TIMERS];
+static uint16_t TimersUsed;		// bit per timer
+static uint32_t TimerClock = BUS_CLK;		// bus clock timers run on now, set by Timer_Rescale
+static uint32_t SysTickRequested;			// 0 until SysTick_Init
+static uint32_t SysTickClock;
+
+#define SYSTICK_MAX		0x01000000		// reload is 24 bits
+
+
+/** SysTick_Init
+ * Initialize Systick interrupt and values 
+ * Make sure this is the second to lowest priority
+ */
+void SysTick_Init(uint32_t period){
+	NVIC_ST_CTRL_R = 0;         // disable SysTick during setup
+	NVIC_ST_CURRENT_R = 0;      // any write to current clears it
+	NVIC_SYS_PRI3_R =(NVIC_SYS_PRI3_R&0x00FFFFFF)|0xD0000000; // priority 6
+	NVIC_SYS_PRI3_R =(NVIC_SYS_PRI3_R&0xFF00FFFF)|0x00E00000; // priority 7
+	NVIC_ST_RELOAD_R = period - 1; // reload value
+	NVIC_ST_CTRL_R = 0x00000007; // enable, core clock and interrupt arm
+	SysTickRequested = period;
+	SysTickClock = TimerClock;
+}
+
+/** ScalePeriod
+ * Period asked for at one clock in cycles of another, rounded so going back gives same value
+ * @param period bus cycles at clock
+ * @param clock clock period was asked for at (Hz)
+ * @param newClock clock to convert to (Hz)
+ * @return bus cycles at newClock
+ */
+static uint32_t ScalePeriod(uint32_t period, uint32_t clock, uint32_t newClock){
+	return ((uint64_t)period*newClock + clock/2)/clock;
+}
+
+/** TimerLoad
+ * Write reload and restart count, interrupts off
+ * @param timer timer id
+ * @param period bus cycles
+ */
+static void TimerLoad(uint32_t timer, uint32_t period){
+	const TimerDesc *t = &Timers[timer];
+	Periods[timer] = period;
+	t->base[TIMER_ILR + t->half] = period - 1;
+	t->base[TIMER_V + t->half] = period - 1;
+}
+
+/** Timer_Init
+ * Setup timer as periodic interrupt and start it, timer is marked used
+ * @param timer TIMER0A-TIMER4B
+ * @param task function run every period from ISR
+ * @param period bus cycles
+ * @param priority NVIC priority 0-7
+ */
+void Timer_Init(uint32_t timer, void (*task)(void), uint32_t period, uint32_t priority){
+	const TimerDesc *t = &Timers[timer];
+	volatile uint32_t *base = t->base;
+	uint32_t shift = t->half*8;
+	uint32_t sr = StartCritical();
+	SYSCTL_RCGCTIMER_R |= t->rcgc;   // 0) activate timer
+	Tasks[timer] = task;
+	Periods[timer] = period;
+	Requested[timer] = period;
+	RequestClock[timer] = TimerClock;
+	TimersUsed |= 1 << timer;
+	base[TIMER_CTL] &= ~(TIMER_CTL_TAEN << shift);    // 1) disable during setup
+	base[TIMER_CFG] = TIMER_CFG_32_BIT_TIMER;    // 2) configure for 32-bit mode
+	base[TIMER_MR + t->half] = TIMER_TAMR_TAMR_PERIOD;   // 3) configure for periodic mode, default down-count settings
+	base[TIMER_ILR + t->half] = period - 1;    // 4) reload value
+	base[TIMER_PR + t->half] = 0;            // 5) bus clock resolution
+	base[TIMER_ICR] = TIMER_ICR_TATOCINT << shift;    // 6) clear timeout flag
+	base[TIMER_IMR] |= TIMER_IMR_TATOIM << shift;    // 7) arm timeout interrupt
+	// 8) priority, one byte per IRQ with priority in top 3 bits
+	((volatile uint8_t *)&NVIC_PRI0_R)[t->irq] = (priority & 0x07) << 5;
+	// interrupts enabled in the main program after all devices initialized
+	(&NVIC_EN0_R)[t->irq >> 5] = 1 << (t->irq & 31);    // 9) enable IRQ in NVIC, write 1 to set
+	base[TIMER_CTL] |= TIMER_CTL_TAEN << shift;    // 10) enable timer
+	EndCritical(sr);
+}
+
+/** Timer_Alloc
+ * Take first unused timer and start it
+ * @param task function run every period from ISR
+ * @param period bus cycles
+ * @param priority NVIC priority 0-7
+ * @return timer id, -1 if all in use
+ */
+int32_t Timer_Alloc(void (*task)(void), uint32_t period, uint32_t priority){
+	uint32_t sr = StartCritical();
+	for(uint32_t timer = 0; timer < NUM_TIMERS; timer++){
+		if(!(TimersUsed & (1 << timer))){
+			// claim before init so ISR cant take it
+			TimersUsed |= 1 << timer;
+			EndCritical(sr);
+			Timer_Init(timer, task, period, priority);
+			return timer;
+		}
+	}
+	EndCritical(sr);
+	return -1;
+}
+
+/** Timer_Stop
+ * Stop timer counting, keeps it allocated, Timer_Start resumes
+ * @param timer timer id
+ */
+void Timer_Stop(uint32_t timer){
+	const TimerDesc *t = &Timers[timer];
+	uint32_t sr = StartCritical();
+	t->base[TIMER_CTL] &= ~(TIMER_CTL_TAEN << (t->half*8));
+	t->base[TIMER_ICR] = TIMER_ICR_TATOCINT << (t->half*8);
+	EndCritical(sr);
+}
+
+/** Timer_Start
+ * Restart stopped timer from full period
+ * @param timer timer id
+ */
+void Timer_Start(uint32_t timer){
+	const TimerDesc *t = &Timers[timer];
+	uint32_t sr = StartCritical();
+	t->base[TIMER_V + t->half] = Periods[timer] - 1;
+	t->base[TIMER_CTL] |= TIMER_CTL_TAEN << (t->half*8);
+	EndCritical(sr);
+}
+
+/** Timer_SetPeriod
+ * Change period, count restarts from new period now
+ * @param timer timer id
+ * @param period bus cycles
+ */
+void Timer_SetPeriod(uint32_t timer, uint32_t period){
+	uint32_t sr = StartCritical();
+	Requested[timer] = period;
+	RequestClock[timer] = TimerClock;
+	TimerLoad(timer, period);
+	EndCritical(sr);
+}
+
+/** Timer_GetPeriod
+ * @param timer timer id
+ * @return period in bus cycles, 0 if timer not in use
+ */
+uint32_t Timer_GetPeriod(uint32_t timer){
+	return (TimersUsed & (1 << timer)) ? Periods[timer] : 0;
+}
+
+/** Timer_RescaleFits
+ * Check SysTick reload still fits 24 bits at new clock, call before changing clock
+ * @param newClock new bus clock (Hz)
+ * @return 1 if Timer_Rescale can keep every period, 0 if not
+ */
+int32_t Timer_RescaleFits(uint32_t newClock){
+	if(SysTickRequested == 0){
+		return 1;
+	}
+	return ScalePeriod(SysTickRequested, SysTickClock, newClock) <= SYSTICK_MAX;
+}
+
+/** Timer_Rescale
+ * Keep SysTick and every used timer at same real time period after bus clock change,
+ * periods are recomputed from the requested ones so repeated changes do not drift
+ * @param newClock new bus clock (Hz)
+ */
+void Timer_Rescale(uint32_t newClock){
+	uint32_t sr = StartCritical();
+	TimerClock = newClock;
+	if(SysTickRequested){
+		NVIC_ST_RELOAD_R = ScalePeriod(SysTickRequested, SysTickClock, newClock) - 1;
+		NVIC_ST_CURRENT_R = 0;
+	}
+	for(uint32_t timer = 0; timer < NUM_TIMERS; timer++){
+		if(TimersUsed & (1 << timer)){
+			TimerLoad(timer, ScalePeriod(Requested[timer], RequestClock[timer], newClock));
+		}
+	}
+	EndCritical(sr);
+}
+
+/** Timer_Release
+ * Stop timer, disable its IRQ and give it back for Timer_Alloc
+ * @param timer timer id
+ */
+void Timer_Release(uint32_t timer){
+	const TimerDesc *t = &Timers[timer];
+	uint32_t sr = StartCritical();
+	Timer_Stop(timer);
+	t->base[TIMER_IMR] &= ~(TIMER_IMR_TATOIM << (t->half*8));
+	(&NVIC_DIS0_R)[t->irq >> 5] = 1 << (t->irq & 31);   // write 1 to clear enable
+	Tasks[timer] = 0;
+	TimersUsed &= ~(1 << timer);
+	EndCritical(sr);
+}
+
+/** Timer_Handler
+ * Shared ISR body, acknowledge timeout and run task
+ * @param timer timer id
+ */
+static void Timer_Handler(uint32_t timer){
+	const TimerDesc *t = &Timers[timer];
+	t->base[TIMER_ICR] = TIMER_ICR_TATOCINT << (t->half*8);// acknowledge timeout
+	Tasks[timer]();
+}
+
+// vector table entries
+void Timer0A_Handler(void){ Timer_Handler(TIMER0A); }
+void Timer0B_Handler(void){ Timer_Handler(TIMER0B); }
+void Timer1A_Handler(void){ Timer_Handler(TIMER1A); }
+void Timer1B_Handler(void){ Timer_Handler(TIMER1B); }
+void Timer2A_Handler(void){ Timer_Handler(TIMER2A); }
+void Timer2B_Handler(void){ Timer_Handler(TIMER2B); }
+void Timer3A_Handler(void){ Timer_Handler(TIMER3A); }
+void Timer3B_Handler(void){ Timer_Handler(TIMER3B); }
+void Timer4A_Handler(void){ Timer_Handler(TIMER4A); }
+void Timer4B_Handler(void){ Timer_Handler(TIMER4B); }
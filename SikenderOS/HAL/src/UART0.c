@@ -22,6 +22,9 @@
 
 #include "UART0.h"
 #include "FIFO.h"
+#include "cpu.h"
+
+#define UART_BAUD				115200
 
 // Initialization
 #define NVIC_EN0_INT5           0x00000020  // Interrupt 5 enable
@@ -56,24 +59,62 @@ void WaitForInterrupt(void);  // low power mode
 #define FIFOSUCCESS 1         // return value on success
 #define FIFOFAIL    0         // return value on failure
                               // create index implementation FIFO (see FIFO.h)
-AddIndexFifo(Rx, FIFOSIZE, char, FIFOSUCCESS, FIFOFAIL)
 AddIndexFifo(Tx, FIFOSIZE, char, FIFOSUCCESS, FIFOFAIL)
+                              // RX goes through a kernel stream so readers can sleep
+static char RxBuffer[FIFOSIZE];
+static StreamType RxStream;
 
 Sema4Type semaUART;
+
+// Baud divisor = bus / (16 * baud), IBRD integer part, FBRD 64ths rounded
+// LCRH write after divisors is what makes UART latch them
+static void UART_SetDivisors(uint32_t busClock){
+  uint32_t div = (busClock*8/UART_BAUD + 1)/2;   // divisor in 64ths
+  UART0_IBRD_R = div >> 6;
+  UART0_FBRD_R = div & 0x3F;
+                                        // 8 bit word length (no parity bits, one stop bit, FIFOs)
+  UART0_LCRH_R = (UART_LCRH_WLEN_8|UART_LCRH_FEN);
+}
+
+//------------UART_Drain------------
+// Lock out writers and wait until every queued byte has been
+// shifted out, call before bus clock changes so none go at wrong baud
+// Interrupts must be on, UART0_Handler empties TxFifo
+// Input: none
+// Output: none
+void UART_Drain(void){
+  OS_Wait(&semaUART);
+  while(TxFifo_Size() > 0){};
+  while(UART0_FR_R&UART_FR_BUSY){};     // hardware FIFO and shift register empty
+}
+
+//------------UART_Release------------
+// Let writers back in after UART_Drain
+// Input: none
+// Output: none
+void UART_Release(void){
+  OS_Signal(&semaUART);
+}
+
+//------------UART_SetBusClock------------
+// Recompute baud divisors after bus clock change, UART_Drain first
+// Input: new bus clock in Hz
+// Output: none
+void UART_SetBusClock(uint32_t busClock){
+  UART0_CTL_R &= ~UART_CTL_UARTEN;
+  UART_SetDivisors(busClock);
+  UART0_CTL_R |= UART_CTL_UARTEN;
+}
+
 // Initialize UART0
 // Baud rate is 115200 bits/sec
 void UART_Init(void){
   SYSCTL_RCGCUART_R |= 0x01;            // activate UART0
   SYSCTL_RCGCGPIO_R |= 0x01;            // activate port A
-  RxFifo_Init();                        // initialize empty FIFOs
+  OS_StreamInit(&RxStream, RxBuffer, FIFOSIZE, 1); // initialize empty FIFOs
   TxFifo_Init();
   UART0_CTL_R &= ~UART_CTL_UARTEN;      // disable UART
-//  UART0_IBRD_R = 27;                    // IBRD = int(50,000,000 / (16 * 115,200)) = int(27.1267)
-//  UART0_FBRD_R = 8;                     // FBRD = int(0.1267 * 64 + 0.5) = 8
-	UART0_IBRD_R = 43;                    // IBRD = int(80,000,000 / (16 * 115,200)) = int(43.4027)
-  UART0_FBRD_R = 26;                     // FBRD = int(0.4027 * 64 + 0.5) = 26
-                                        // 8 bit word length (no parity bits, one stop bit, FIFOs)
-  UART0_LCRH_R = (UART_LCRH_WLEN_8|UART_LCRH_FEN);
+  UART_SetDivisors(BUS_CLK);            // 80 MHz: IBRD = 43, FBRD = 26
   UART0_IFLS_R &= ~0x3F;                // clear TX and RX interrupt FIFO level fields
                                         // configure interrupt for TX FIFO <= 1/8 full
                                         // configure interrupt for RX FIFO >= 1/8 full
@@ -94,12 +135,15 @@ void UART_Init(void){
 }
 // copy from hardware RX FIFO to software RX FIFO
 // stop when hardware RX FIFO is empty or software RX FIFO is full
+// hardware FIFO is 16 deep, move it in one stream write so reader wakes once
 void static copyHardwareToSoftware(void){
-  char letter;
-  while(((UART0_FR_R&UART_FR_RXFE) == 0) && (RxFifo_Size() < (FIFOSIZE - 1))){
-    letter = UART0_DR_R;
-    RxFifo_Put(letter);
+  char letters[16];
+  uint32_t n = 0;
+  uint32_t space = OS_StreamSpace(&RxStream);
+  while(((UART0_FR_R&UART_FR_RXFE) == 0) && (n < space) && (n < sizeof(letters))){
+    letters[n++] = UART0_DR_R;
   }
+  OS_StreamWrite(&RxStream, letters, n);
 }
 // copy from software TX FIFO to hardware TX FIFO
 // stop when software TX FIFO is empty or hardware TX FIFO is full
@@ -111,12 +155,24 @@ void static copySoftwareToHardware(void){
   }
 }
 // input ASCII character from UART
-// spin if RxFifo is empty
+// block if RxStream is empty
 char UART_InChar(void){
   char letter;
-  while(RxFifo_Get(&letter) == FIFOFAIL){};
+  OS_StreamRead(&RxStream, &letter, 1, 1, OS_WAIT_FOREVER);
   return(letter);
 }
+
+//------------UART_InBlock------------
+// Wait until at least min bytes have been received, or timeout
+// Input: pointer to buffer, min bytes to wait for, max bytes to read,
+//        timeout in ms (OS_WAIT_FOREVER never times out)
+// Output: number of bytes copied to buffer
+uint32_t UART_InBlock(char *bufPt, uint32_t min, uint32_t max, uint32_t timeout){
+  if(min == 0){
+    min = 1;
+  }
+  return OS_StreamRead(&RxStream, bufPt, max, min, timeout);
+}
 // output ASCII character to UART
 // spin if TxFifo is full
 void UART_OutChar(char data){
@@ -132,6 +188,7 @@ void UART_OutChar(char data){
 // hardware RX FIFO goes from 1 to 2 or more items
 // UART receiver has timed out
 void UART0_Handler(void){
+  OS_TRACE_ISR_ENTER();
   if(UART0_RIS_R&UART_RIS_TXRIS){       // hardware TX FIFO <= 2 items
     UART0_ICR_R = UART_ICR_TXIC;        // acknowledge TX FIFO
     // copy from software TX FIFO to hardware TX FIFO
@@ -150,6 +207,7 @@ void UART0_Handler(void){
     // copy from hardware RX FIFO to software RX FIFO
     copyHardwareToSoftware();
   }
+  OS_TRACE_ISR_EXIT();
 }
 
 //------------UART_OutString------------
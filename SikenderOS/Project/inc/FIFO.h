@@ -1,114 +1,202 @@
-/**
-* @file FIFO.h
-* @brief Provides Functions to initialize FIFO, uses index implementation and macro
-* @author Valvano
-* @date 2/04/2019
-*/
-
-/* This example accompanies the book
-   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
-   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
-      Programs 3.7, 3.8., 3.9 and 3.10 in Section 3.7
-
- Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
-    You may use, edit, run or distribute this file
-    as long as the above copyright notice remains
- THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
- OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
- MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
- VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
- OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
- For more information about my classes, my research, and my books, see
- http://users.ece.utexas.edu/~valvano/
- */
- // Example:
-// AddPointerFifo(Rx,32,unsigned char, 1,0)
-// SIZE can be any size
-// creates RxFifo_Init() RxFifo_Get() and RxFifo_Put()
-
-
-#ifndef __FIFO_H__
-#define __FIFO_H__
-
-#include "startup.h"
-#include "cpu_vars.h"
-
-
-// macro to create an index FIFO
-#define AddIndexFifo(NAME,SIZE,TYPE,SUCCESS,FAIL) \
-uint32_t volatile NAME ## PutI;    \
-uint32_t volatile NAME ## GetI;    \
-TYPE static NAME ## Fifo [SIZE];        \
-void NAME ## Fifo_Init(void){ long sr;  \
-  sr = StartCritical();                 \
-  NAME ## PutI = NAME ## GetI = 0;      \
-  EndCritical(sr);                      \
-}                                       \
-int NAME ## Fifo_Put (TYPE data){       \
-  if(( NAME ## PutI - NAME ## GetI ) & ~(SIZE-1)){  \
-    return(FAIL);      \
-  }                    \
-  NAME ## Fifo[ NAME ## PutI &(SIZE-1)] = data; \
-  NAME ## PutI ## ++;  \
-  return(SUCCESS);     \
-}                      \
-int NAME ## Fifo_Get (TYPE *datapt){  \
-  if( NAME ## PutI == NAME ## GetI ){ \
-    return(FAIL);      \
-  }                    \
-  *datapt = NAME ## Fifo[ NAME ## GetI &(SIZE-1)];  \
-  NAME ## GetI ## ++;  \
-  return(SUCCESS);     \
-}                      \
-unsigned short NAME ## Fifo_Size (void){  \
- return ((unsigned short)( NAME ## PutI - NAME ## GetI ));  \
-}
-// e.g.,
-// AddIndexFifo(Tx,32,unsigned char, 1,0)
-// SIZE must be a power of two
-// creates TxFifo_Init() TxFifo_Get() and TxFifo_Put()
-
-// macro to create a pointer FIFO
-#define AddPointerFifo(NAME,SIZE,TYPE,SUCCESS,FAIL) \
-TYPE volatile *NAME ## PutPt;    \
-TYPE volatile *NAME ## GetPt;    \
-TYPE static NAME ## Fifo [SIZE];        \
-void NAME ## Fifo_Init(void){ long sr;  \
-  sr = StartCritical();                 \
-  NAME ## PutPt = NAME ## GetPt = &NAME ## Fifo[0]; \
-  EndCritical(sr);                      \
-}                                       \
-int NAME ## Fifo_Put (TYPE data){       \
-  TYPE volatile *nextPutPt;             \
-  nextPutPt = NAME ## PutPt + 1;        \
-  if(nextPutPt == &NAME ## Fifo[SIZE]){ \
-    nextPutPt = &NAME ## Fifo[0];       \
-  }                                     \
-  if(nextPutPt == NAME ## GetPt ){      \
-    return(FAIL);                       \
-  }                                     \
-  else{                                 \
-    *( NAME ## PutPt ) = data;          \
-    NAME ## PutPt = nextPutPt;          \
-    return(SUCCESS);                    \
-  }                                     \
-}                                       \
-int NAME ## Fifo_Get (TYPE *datapt){    \
-  if( NAME ## PutPt == NAME ## GetPt ){ \
-    return(FAIL);                       \
-  }                                     \
-  *datapt = *( NAME ## GetPt ## ++);    \
-  if( NAME ## GetPt == &NAME ## Fifo[SIZE]){ \
-    NAME ## GetPt = &NAME ## Fifo[0];   \
-  }                                     \
-  return(SUCCESS);                      \
-}                                       \
-unsigned short NAME ## Fifo_Size (void){\
-  if( NAME ## PutPt < NAME ## GetPt ){  \
-    return ((INT32U)( NAME ## PutPt - NAME ## GetPt + (SIZE*sizeof(TYPE)))/sizeof(TYPE)); \
-  }                                     \
-  return ((INT32U)( NAME ## PutPt - NAME ## GetPt )/sizeof(TYPE)); \
-}
-
-
-#endif //  __FIFO_H__
+/**
+* @file FIFO.h
+* @brief Provides Functions to initialize FIFO, uses index implementation and macro
+* @author Valvano
+* @date 2/04/2019
+*/
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+      Programs 3.7, 3.8., 3.9 and 3.10 in Section 3.7
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+ // Example:
+// AddPointerFifo(Rx,32,unsigned char, 1,0)
+// SIZE can be any size
+// creates RxFifo_Init() RxFifo_Get() and RxFifo_Put()
+
+
+#ifndef __FIFO_H__
+#define __FIFO_H__
+
+#include <string.h>
+#include "startup.h"
+#include "cpu_vars.h"
+#include "OS.h"
+
+
+// macro to create an index FIFO
+#define AddIndexFifo(NAME,SIZE,TYPE,SUCCESS,FAIL) \
+uint32_t volatile NAME ## PutI;    \
+uint32_t volatile NAME ## GetI;    \
+TYPE static NAME ## Fifo [SIZE];        \
+void NAME ## Fifo_Init(void){ long sr;  \
+  sr = StartCritical();                 \
+  NAME ## PutI = NAME ## GetI = 0;      \
+  EndCritical(sr);                      \
+}                                       \
+int NAME ## Fifo_Put (TYPE data){       \
+  if(( NAME ## PutI - NAME ## GetI ) & ~(SIZE-1)){  \
+    return(FAIL);      \
+  }                    \
+  NAME ## Fifo[ NAME ## PutI &(SIZE-1)] = data; \
+  NAME ## PutI ## ++;  \
+  return(SUCCESS);     \
+}                      \
+int NAME ## Fifo_Get (TYPE *datapt){  \
+  if( NAME ## PutI == NAME ## GetI ){ \
+    return(FAIL);      \
+  }                    \
+  *datapt = NAME ## Fifo[ NAME ## GetI &(SIZE-1)];  \
+  NAME ## GetI ## ++;  \
+  return(SUCCESS);     \
+}                      \
+unsigned short NAME ## Fifo_Size (void){  \
+ return ((unsigned short)( NAME ## PutI - NAME ## GetI ));  \
+}                      \
+int NAME ## Fifo_PutN (const TYPE *data, int n){  \
+  uint32_t room = SIZE - ( NAME ## PutI - NAME ## GetI ); \
+  uint32_t idx = NAME ## PutI &(SIZE-1); \
+  uint32_t first;      \
+  if((uint32_t)n > room){ \
+    n = room;          \
+  }                    \
+  first = SIZE - idx;  \
+  if(first > (uint32_t)n){ \
+    first = n;         \
+  }                    \
+  memcpy(&NAME ## Fifo[idx], data, first*sizeof(TYPE)); \
+  memcpy(&NAME ## Fifo[0], &data[first], (n-first)*sizeof(TYPE)); \
+  NAME ## PutI += n;   \
+  return(n);           \
+}                      \
+int NAME ## Fifo_GetN (TYPE *datapt, int n){  \
+  uint32_t size = NAME ## PutI - NAME ## GetI; \
+  uint32_t idx = NAME ## GetI &(SIZE-1); \
+  uint32_t first;      \
+  if((uint32_t)n > size){ \
+    n = size;          \
+  }                    \
+  first = SIZE - idx;  \
+  if(first > (uint32_t)n){ \
+    first = n;         \
+  }                    \
+  memcpy(datapt, &NAME ## Fifo[idx], first*sizeof(TYPE)); \
+  memcpy(&datapt[first], &NAME ## Fifo[0], (n-first)*sizeof(TYPE)); \
+  NAME ## GetI += n;   \
+  return(n);           \
+}
+// e.g.,
+// AddIndexFifo(Tx,32,unsigned char, 1,0)
+// SIZE must be a power of two
+// creates TxFifo_Init() TxFifo_Get() and TxFifo_Put()
+// TxFifo_PutN() and TxFifo_GetN() move blocks with at most two memcpy
+// and return how many items were moved
+
+// macro to create a pointer FIFO
+#define AddPointerFifo(NAME,SIZE,TYPE,SUCCESS,FAIL) \
+TYPE volatile *NAME ## PutPt;    \
+TYPE volatile *NAME ## GetPt;    \
+TYPE static NAME ## Fifo [SIZE];        \
+void NAME ## Fifo_Init(void){ long sr;  \
+  sr = StartCritical();                 \
+  NAME ## PutPt = NAME ## GetPt = &NAME ## Fifo[0]; \
+  EndCritical(sr);                      \
+}                                       \
+int NAME ## Fifo_Put (TYPE data){       \
+  TYPE volatile *nextPutPt;             \
+  nextPutPt = NAME ## PutPt + 1;        \
+  if(nextPutPt == &NAME ## Fifo[SIZE]){ \
+    nextPutPt = &NAME ## Fifo[0];       \
+  }                                     \
+  if(nextPutPt == NAME ## GetPt ){      \
+    return(FAIL);                       \
+  }                                     \
+  else{                                 \
+    *( NAME ## PutPt ) = data;          \
+    NAME ## PutPt = nextPutPt;          \
+    return(SUCCESS);                    \
+  }                                     \
+}                                       \
+int NAME ## Fifo_Get (TYPE *datapt){    \
+  if( NAME ## PutPt == NAME ## GetPt ){ \
+    return(FAIL);                       \
+  }                                     \
+  *datapt = *( NAME ## GetPt ## ++);    \
+  if( NAME ## GetPt == &NAME ## Fifo[SIZE]){ \
+    NAME ## GetPt = &NAME ## Fifo[0];   \
+  }                                     \
+  return(SUCCESS);                      \
+}                                       \
+unsigned short NAME ## Fifo_Size (void){\
+  if( NAME ## PutPt < NAME ## GetPt ){  \
+    return ((INT32U)( NAME ## PutPt - NAME ## GetPt + (SIZE*sizeof(TYPE)))/sizeof(TYPE)); \
+  }                                     \
+  return ((INT32U)( NAME ## PutPt - NAME ## GetPt )/sizeof(TYPE)); \
+}
+
+// e.g.,
+// AddMpscFifo(Isr,32,INT32U, 1,0)
+// SIZE must be a power of two
+// creates IsrFifo_Init() IsrFifo_Get() and IsrFifo_Put()
+// Put is lock free and safe from any number of ISRs/threads at once,
+// Get must only be called by one consumer. Slots are reserved with
+// LDREX/STREX on the put index (OS_ASM_CompareSwap), each slot has a
+// sequence number so the consumer only reads slots that are published
+// host stress test with pthreads: tools/mpsc_stress.c
+
+// macro to create a multi-producer single-consumer lock free FIFO
+#define AddMpscFifo(NAME,SIZE,TYPE,SUCCESS,FAIL) \
+INT32U volatile NAME ## PutI;    \
+INT32U volatile NAME ## GetI;    \
+INT32U volatile static NAME ## Seq [SIZE];  \
+TYPE volatile static NAME ## Fifo [SIZE];   \
+void NAME ## Fifo_Init(void){ long sr; INT32U i; \
+  sr = StartCritical();                 \
+  NAME ## PutI = NAME ## GetI = 0;      \
+  for(i = 0; i < SIZE; i++){            \
+    NAME ## Seq[i] = i;                 \
+  }                                     \
+  EndCritical(sr);                      \
+}                                       \
+int NAME ## Fifo_Put (TYPE data){       \
+  INT32U pos;                           \
+  INT32 diff;                           \
+  do{                                   \
+    pos = NAME ## PutI;                 \
+    diff = (INT32)(NAME ## Seq[pos &(SIZE-1)] - pos); \
+    if(diff < 0){                       \
+      return(FAIL);                     \
+    }                                   \
+  }while((diff != 0) || (OS_ASM_CompareSwap(&NAME ## PutI, pos, pos+1) == 0)); \
+  NAME ## Fifo[pos &(SIZE-1)] = data;   \
+  NAME ## Seq[pos &(SIZE-1)] = pos+1;   \
+  return(SUCCESS);                      \
+}                                       \
+int NAME ## Fifo_Get (TYPE *datapt){    \
+  INT32U pos = NAME ## GetI;            \
+  if( NAME ## Seq[pos &(SIZE-1)] != pos+1 ){ \
+    return(FAIL);                       \
+  }                                     \
+  *datapt = NAME ## Fifo[pos &(SIZE-1)]; \
+  NAME ## Seq[pos &(SIZE-1)] = pos+SIZE; \
+  NAME ## GetI = pos+1;                 \
+  return(SUCCESS);                      \
+}                                       \
+unsigned short NAME ## Fifo_Size (void){  \
+ return ((unsigned short)( NAME ## PutI - NAME ## GetI ));  \
+}
+
+
+#endif //  __FIFO_H__
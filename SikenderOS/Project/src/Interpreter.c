@@ -338,7 +338,13 @@ void printHelpMenu(void){
 	printf("Description:\n\r");
 	printf("This interfaces with the OS. Currently not much support is available.\n\r");
 	printf("Read and clear are only available\n\r\n\r");
-	printf("  set\t\tReads/clears the periodic time counter of the OS.\n\r\n\r");
+	printf("  set\t\tReads/clears the periodic time counter of the OS.\n\r");
+	printf("\t\t-jitter prints periodic thread jitter histograms (1/BUS_CLK units),\n\r");
+	printf("\t\t-jitter -clear resets them.\n\r");
+	printf("\t\t-threads prints cpu time and context switches per thread.\n\r");
+	printf("\t\t-trace dumps event trace for tools/trace2chrome.py.\n\r");
+	printf("\t\t-crit prints longest critical sections and wake-to-run latency,\n\r");
+	printf("\t\t-crit -clear resets them.\n\r\n\r");
 }
 
 /** commandMeasure
@@ -416,6 +422,69 @@ void commandOS(char cmd[MAX_WORDS][MAX_CHARS_PER_WORD]){
 	}else if(strcmp(cmd[1], "clear") == 0 || strcmp(cmd[1], "-clear") == 0){
 		OS_ClearMsTime();
 		printf("Periodic Cleared.\n\r");
+	}else if(strcmp(cmd[1], "threads") == 0 || strcmp(cmd[1], "-threads") == 0){
+		for(INT32U id = 0; id < NUMTHREADS; id++){
+			ThreadStatsType stats;
+			if(OS_GetThreadStats(id, &stats)){
+				printf("Thread %d pri %d: %u ms run, %d in, %d preempted, %d yielded\n\r", stats.id, stats.priority,
+					(INT32U)(stats.runCycles/OS_TIME_1MS), stats.switchesIn, stats.preemptions, stats.yields);
+			}
+		}
+	}else if(strcmp(cmd[1], "trace") == 0 || strcmp(cmd[1], "-trace") == 0){
+#if OS_TRACE
+		// header then events as hex words, feed to tools/trace2chrome.py
+		INT32U *words = (INT32U*)&OS_TraceLog;
+		printf("TRACE\n\r");
+		for(INT32U i = 0; i < sizeof(OS_TraceLog)/4; i += 4){
+			printf("%08x %08x %08x %08x\n\r", words[i], words[i+1], words[i+2], words[i+3]);
+		}
+		printf("END\n\r");
+#else
+		printf("Trace disabled, set OS_TRACE in OSConfig.h\n\r");
+#endif
+	}else if(strcmp(cmd[1], "crit") == 0 || strcmp(cmd[1], "-crit") == 0){
+#if OS_CSPROFILE
+		CritStatsType worst[8];
+		INT32U n;
+		if(strcmp(cmd[2], "clear") == 0 || strcmp(cmd[2], "-clear") == 0){
+			OS_CSClear();
+			printf("Critical Stats Cleared.\n\r");
+			return;
+		}
+		// sites are return addresses, look them up in the map file
+		n = OS_CSWorst(worst, 8);
+		for(INT32U i = 0; i < n; i++){
+			printf("Site %08x: n=%u max=%u avg=%u (1/BUS_CLK)\n\r", (INT32U)worst[i].site, worst[i].count,
+				worst[i].maxCycles, (INT32U)(worst[i].totalCycles/worst[i].count));
+		}
+		for(INT32U id = 0; id < NUMTHREADS; id++){
+			ThreadStatsType stats;
+			if(OS_GetThreadStats(id, &stats) && stats.wakeCount){
+				printf("Thread %d wake-to-run: n=%u max=%u avg=%u (1/BUS_CLK)\n\r", stats.id, stats.wakeCount,
+					stats.wakeMax, (INT32U)(stats.wakeTotal/stats.wakeCount));
+			}
+		}
+#else
+		printf("Profiling disabled, set OS_CSPROFILE in OSConfig.h\n\r");
+#endif
+	}else if(strcmp(cmd[1], "jitter") == 0 || strcmp(cmd[1], "-jitter") == 0){
+		if(strcmp(cmd[2], "clear") == 0 || strcmp(cmd[2], "-clear") == 0){
+			OS_ClearJitter();
+			printf("Jitter Cleared.\n\r");
+			return;
+		}
+		for(INT32U id = 0; id < OS_PeriodicCount(); id++){
+			JitterType stats;
+			OS_GetJitter(id, &stats);
+			printf("Task %d: n=%d min=%d max=%d (1/BUS_CLK)\n\r", id, stats.count, stats.min, stats.max);
+			for(INT32U k = 0; k < JITTER_BUCKETS; k++){
+				if(stats.buckets[k] && k == JITTER_BUCKETS - 1){
+					printf("  >=%d: %d\n\r", 1 << (k - 1), stats.buckets[k]);
+				}else if(stats.buckets[k]){
+					printf("  <%d: %d\n\r", 1 << k, stats.buckets[k]);
+				}
+			}
+		}
 	}
 }
 
@@ -1,254 +1,1274 @@
-/**
-* @file OS.h
-* @brief Functions for OS
-*/
-#ifndef __OS_H
-#define __OS_H  
-
-
-#include "OSConfig.h"
-#include "cpu_vars.h"
-
-
-/** Semaphore 
- * Semaphore structure
-*/
-struct  Sema4{
-	INT32 Value;   // 0 is free, >0 not free I think       
-	struct Tcb* blockThreads;
-};
-typedef struct Sema4 Sema4Type;
-
-
-/** Mailbox 
- * Contains data and semaphores for mailbox 
- * interthread communication
-*/
-struct MailBox{
-	Sema4Type Empty;
-	Sema4Type Full;
-	INT32U data;
-};
-typedef struct MailBox MailBoxType;
-
-
-/** OS_Init
- * Initializes operating system, disables interrupts until OS_Launch
- * Initializes all I/O and interthread communication
-*/
-void OS_Init(void); 
-
-
-/** OS_InitSemaphore
- * Initializes semaphore to default value sent
- * @param semaPt pointer to semaphore
- * @param value value of semaphore
-*/
-void OS_InitSemaphore(Sema4Type *semaPt, INT32 value); 
-
-
-/** OS_Wait
- * Wait on semaphore, if busy yield
- * @param semaPt pointer to semaphore
-*/
-void OS_Wait(Sema4Type *semaPt); 
-
-
-/** OS_Signal
- * Clear Semaphore, Increment
-*/
-void OS_Signal(Sema4Type *semaPt); 
-
-
-/** OS_bWait
- * @brief Wait on semaphore, binary
- * @param semaPt pointer to semaphore
-*/
-void OS_bWait(Sema4Type *semaPt); 
-
-
-
-/** OS_bSignal
- * @brief Signal semaphore to be free, set to 1
-*/
-void OS_bSignal(Sema4Type *semaPt); 
-
-
-/** OS_ASM_Signal
- * @brief Spinlock semaphore signal using ARM exclusion
-*/
-void OS_ASM_Signal(Sema4Type *semaPt);
-
-
-
-/** OS_ASM_Signal
- * @brief Spinlock semaphore wait using ARM exclusion
-*/
-void OS_ASM_Wait(Sema4Type *semaPt);
-
-
-/** OS_AddThread
- * Add new thread to OS, Linked List style
- * @param task task to run for thread
- * @param stackSize size of stack
- * @param priority priority of thread
- * @return success: 1, fail: 0
-*/
-INT8 OS_AddThread(void(*task)(void), INT32U priority);
-
- 
-/** OS_Id
- * return ID of current thread
- * @return ID of thread
-*/
-INT32U OS_IdThread(void);
-
-
-/** OS_AddPeriodicThread
- * Add new thread to OS that runs periodically, uses Timer4
- * @param task task to run for thread
- * @param stackSize size of stack
- * @param priority priority of thread
- * @return success: 1, fail: 0
-*/
-INT8 OS_AddPeriodicThread(void(*task)(void), INT32U period, INT32U priority);
-
-
-
-/** OS_AddSW1Task
- * Add thread to button PF4
- * @param task task to run for thread
- * @param priority priority of thread
- * @return success: 1, fail: 0
-*/
-INT8 OS_AddSW1Task(void(*task)(void), INT32U priority);
-
-
-/** OS_AddSW1Task
- * Add thread to button PF0
- * @param task task to run for thread
- * @param priority priority of thread
- * @return success: 1, fail: 0
-*/
-INT8 OS_AddSW2Task(void(*task)(void), INT32U priority);
-
-
-/** OS_Sleep
- * Put current thread to sleep then yield
- * @param sleepTime amount of time to sleep (ms)
-*/
-void OS_Sleep(INT32U sleepTime); 
-
-
-
-/** OS_Kill
- * kills current thread
-*/
-void OS_Kill(void); 
-
-
-
-/** OS_Suspend
- * Suspends current thread
-*/
-void OS_Suspend(void);
- 
-
-
-/** OS_Fifo_Init
- * Initialize OS Fifo, size must be power of 2, inits semaphores
-*/
-void OS_Fifo_Init(void);
-
-
-
-/** OS_Fifo_Put
- * Put data to Fifo
- * @param data data to put in Fifo
- * @return success: 1, fail: 0
-*/
-INT8 OS_Fifo_Put(FIFO_t data);  
-
-
-
-/** OS_Fifo_Get
- * Get data from thread
- * @return data
-*/
-FIFO_t OS_Fifo_Get(void);
-
-
-
-/** OS_Fifo_Size
- * Get number of items in FiFo
- * @return size of Fifo
-*/
-INT32U OS_Fifo_Size(void);
-
-
-/** OS_MailBox_Init
- * @brief Initialize mailbox for OS
-*/
-void OS_MailBox_Init(void);
-
-
-/** OS_MailBox_Send
- * Puts data in mailbox
- * @param data
-*/
-void OS_MailBox_Send(INT32U data);
-
-
-/** OS_MailBox_Recv
- * Get data from Mailbox
- * @return data
-*/
-INT32U OS_MailBox_Recv(void);
-
-
-/** OS_Time
- * Returns time in 12.5ns
-*/
-INT32U OS_Time(void);
-
-
-/** OS_TimeDifference
- * Return difference between time
- * @param start start time
- * @param stop stop time
- * @return time difference
-*/
-INT32U OS_TimeDifference(INT32U start, INT32U stop);
-
-
-/** OS_ClearMsTime
- * clear ms time counter
-*/
-void OS_ClearMsTime(void);
-
-
-/** OS_ReadMsTime
- * return time (ms)
- * @return time in ms
-*/
-INT32U OS_ReadMsTime(void);
-
-
-/** OS_Launch
- * Start OS, setup SysTick 
- * @param theTimeSlice Time between context switches
-*/
-void OS_Launch(INT32U theTimeSlice);
-
-
-/** OS_ClearMsTime
- * The following function clears the period time, resets counter
- * @returns 1 if success
- */
-void OS_ClearMsTime(void);
-
-
-
-
-
-#endif // _OS_H_
+/**
+* @file OS.h
+* @brief Functions for OS
+*/
+#ifndef __OS_H
+#define __OS_H  
+
+
+#include "OSConfig.h"
+#include "cpu_vars.h"
+
+
+/** OS_WAIT_FOREVER
+ * Timeout value that blocks until signaled
+*/
+#define OS_WAIT_FOREVER 0xFFFFFFFF
+
+
+/** Semaphore 
+ * Semaphore structure
+*/
+struct  Sema4{
+	INT32 Value;   // 0 is free, >0 not free I think       
+	struct Tcb* blockThreads;
+};
+typedef struct Sema4 Sema4Type;
+
+
+/** Mailbox 
+ * Contains data and semaphores for mailbox 
+ * interthread communication
+*/
+struct MailBox{
+	Sema4Type Empty;
+	Sema4Type Full;
+	INT32U data;
+	INT8U overwrite;	/**< MAILBOX_OVERWRITE: send never blocks, newest value wins */
+};
+typedef struct MailBox MailBoxType;
+
+/** Mailbox modes
+ * MAILBOX_BLOCKING: sender waits until old value received
+ * MAILBOX_OVERWRITE: sender replaces old value, reader gets latest
+*/
+#define MAILBOX_BLOCKING	0
+#define MAILBOX_OVERWRITE	1
+
+
+/** Queue
+ * Message queue, items are copied in/out by value
+ * Storage is owned by the caller, queue only keeps indexes and semaphores
+*/
+struct Queue{
+	INT8U *buffer;		/**< caller storage, depth*itemSize bytes */
+	INT32U itemSize;	/**< size of one item in bytes */
+	INT32U depth;		/**< max number of items */
+	INT32U putIdx;		/**< next slot to write */
+	INT32U getIdx;		/**< next slot to read */
+	INT32U count;		/**< number of items in queue */
+	INT32U dropped;		/**< items lost to full queue or timeout */
+	INT32U putBusy;		/**< producers copying into reserved slots */
+	INT32U putDone;		/**< copied items held back until putBusy is 0 */
+	INT32U getBusy;		/**< consumers copying out of reserved slots */
+	INT32U getDone;		/**< freed slots held back until getBusy is 0 */
+	Sema4Type Full;		/**< items available, consumers block here */
+	Sema4Type Empty;	/**< free slots, producers block here */
+};
+typedef struct Queue QueueType;
+
+
+/** PRIQUEUE_SLOT_SIZE
+ * Bytes of storage one priority queue item takes (link + item rounded to 4)
+*/
+#define PRIQUEUE_SLOT_SIZE(itemSize)	(sizeof(void*) + (((itemSize) + 3) & ~3U))
+
+
+/** PriQueue
+ * Message queue where each item has a priority (0 highest, PRIORITYLEVELS buckets)
+ * Each bucket is a LL of slots, free slots are kept in a free list, all O(1)
+*/
+struct PriQueue{
+	INT8U *buffer;		/**< caller storage, depth*PRIQUEUE_SLOT_SIZE(itemSize) bytes */
+	INT32U itemSize;	/**< size of one item in bytes */
+	INT32U slotSize;	/**< link + item */
+	INT32U depth;		/**< max number of items */
+	INT32U count;		/**< number of items in queue */
+	void *freeList;		/**< unused slots */
+	void *head[PRIORITYLEVELS];	/**< next slot out for each priority */
+	void *tail[PRIORITYLEVELS];	/**< last slot in for each priority */
+	Sema4Type Full;		/**< items available, consumers block here */
+	Sema4Type Empty;	/**< free slots, producers block here */
+};
+typedef struct PriQueue PriQueueType;
+
+
+/** Pool
+ * Fixed size block pool, free blocks are kept in a list stored inside the blocks
+ * Storage is owned by the caller
+*/
+struct Pool{
+	INT8U *buffer;		/**< caller storage, numBlocks*blockSize bytes */
+	INT32U blockSize;	/**< size of block in bytes, multiple of 4 */
+	INT32U numBlocks;	/**< number of blocks */
+	void *freeList;		/**< first free block, each free block holds ptr to next */
+	INT32U numFree;		/**< number of free blocks */
+	INT32U highWater;	/**< most blocks ever in use at once */
+	INT32U failures;	/**< allocs that found pool empty or timed out */
+	Sema4Type Free;		/**< free blocks, blocking alloc waits here */
+};
+typedef struct Pool PoolType;
+
+
+/** PoolStats
+ * Snapshot of pool usage from OS_PoolGetStats
+*/
+struct PoolStats{
+	INT32U blockSize;	/**< size of block in bytes */
+	INT32U numBlocks;	/**< number of blocks */
+	INT32U numFree;		/**< blocks free now */
+	INT32U highWater;	/**< most blocks ever in use at once */
+	INT32U failures;	/**< failed allocs */
+};
+typedef struct PoolStats PoolStatsType;
+
+
+/** HeapStats
+ * Snapshot of heap usage from OS_HeapGetStats
+*/
+struct HeapStats{
+	INT32U totalBytes;		/**< size of arena (HEAP_SIZE) */
+	INT32U usedBytes;		/**< bytes handed out */
+	INT32U freeBytes;		/**< bytes in free blocks */
+	INT32U largestFree;		/**< biggest single alloc that can succeed now */
+	INT32U freeBlocks;		/**< number of free blocks */
+	INT32U fragmentation;	/**< 0-100, 100 - largestFree*100/freeBytes */
+	INT32U failures;		/**< OS_Malloc calls with no fit */
+};
+typedef struct HeapStats HeapStatsType;
+
+
+/** Topic
+ * Publish/subscribe ring, publisher writes each item once,
+ * every subscriber reads it through its own cursor
+*/
+struct Topic{
+	INT8U *buffer;		/**< caller storage, depth*itemSize bytes */
+	INT32U itemSize;	/**< size of item in bytes */
+	INT32U depth;		/**< number of items kept for slow readers */
+	INT32U published;	/**< free running count of items published */
+	struct Subscriber *subscribers;	/**< LL of readers */
+};
+typedef struct Topic TopicType;
+
+
+/** Subscriber
+ * Read cursor of one thread on a topic
+*/
+struct Subscriber{
+	struct Topic *topic;	/**< topic subscribed to */
+	INT32U readCount;		/**< free running count of items read or skipped */
+	INT32U overruns;		/**< items lost because reader fell depth behind */
+	Sema4Type NewData;		/**< signaled by publisher, reader blocks here */
+	struct Subscriber *next;
+};
+typedef struct Subscriber SubscriberType;
+
+
+/** Stream
+ * Byte stream buffer for one writer (usually ISR) and one reader thread
+*/
+struct Stream{
+	INT8U *buffer;			/**< caller storage */
+	INT32U size;			/**< size in bytes, power of 2 */
+	volatile INT32U putIdx;	/**< free running write count */
+	volatile INT32U getIdx;	/**< free running read count */
+	INT32U trigger;			/**< default bytes needed to wake reader */
+	INT32U waitLevel;		/**< bytes blocked reader needs, 0 if not waiting */
+	Sema4Type DataReady;	/**< reader blocks here */
+};
+typedef struct Stream StreamType;
+
+
+/** Timer
+ * Entry in 1 ms timing wheel, used for software timers, sleeps and semaphore timeouts
+*/
+struct Timer{
+	void(*callback)(void);	/**< software timer function */
+	void(*expireFn)(struct Timer *timer);	/**< run by wheel on expire */
+	INT32U period;			/**< ms between expires */
+	INT32U expire;			/**< tick count of next expire */
+	INT8U periodic;			/**< 1 rearm after expire, 0 one-shot */
+	volatile INT8U active;	/**< 1 while armed */
+	struct Timer *next;		/**< wheel slot list */
+	struct Timer **pprev;	/**< link pointing at this timer, O(1) remove */
+};
+typedef struct Timer TimerType;
+
+
+/** Work
+ * Function plus argument, item of deferred work queue and job pool
+*/
+struct Work{
+	void(*fn)(void *arg);	/**< function to run */
+	void *arg;				/**< passed to fn */
+};
+typedef struct Work WorkType;
+
+
+/** Jitter
+ * Activation jitter of periodic thread, deviation from ideal time in OS_Time units
+*/
+struct Jitter{
+	INT32U count;			/**< activations recorded */
+	INT32 min;				/**< most early (negative) or least late */
+	INT32 max;				/**< most late */
+	INT32U buckets[JITTER_BUCKETS];	/**< bucket k counts |deviation| in [2^(k-1), 2^k), last one is everything bigger */
+};
+typedef struct Jitter JitterType;
+
+
+/** ThreadStats
+ * CPU accounting of one thread from OS_GetThreadStats
+*/
+struct ThreadStats{
+	INT32 id;				/**< thread id */
+	INT8U priority;			/**< thread priority */
+	INT64U runCycles;		/**< OS_Time units spent running, includes ISRs that hit it */
+	INT32U switchesIn;		/**< times switched to */
+	INT32U preemptions;		/**< switched out while still ready */
+	INT32U yields;			/**< switched out because it blocked, slept or yielded */
+	INT32U wakeCount;		/**< wakes timed, OS_CSPROFILE only */
+	INT32U wakeMax;			/**< worst OS_Time units from made ready to running */
+	INT64U wakeTotal;		/**< sum of wake-to-run cycles, divide by wakeCount for mean */
+};
+typedef struct ThreadStats ThreadStatsType;
+
+
+/** CritStats
+ * Interrupt-off time of one critical section call site, from OS_CSWorst
+*/
+struct CritStats{
+	void *site;				/**< return address of StartCritical/DisableInterrupts caller, 0 for overflow entry */
+	INT32U count;			/**< sections timed */
+	INT32U maxCycles;		/**< longest section, OS_Time units */
+	INT64U totalCycles;		/**< sum of all sections */
+};
+typedef struct CritStats CritStatsType;
+
+
+// trace event types, layout must match tools/trace2chrome.py
+#define TRACE_SWITCH		1	/**< id new thread, arg old thread */
+#define TRACE_BLOCK			2	/**< id thread, arg low bits of semaphore address */
+#define TRACE_UNBLOCK		3	/**< id thread, arg low bits of semaphore address */
+#define TRACE_TIMEOUT		4	/**< id thread, arg low bits of semaphore address */
+#define TRACE_ISR_ENTER		5	/**< id exception number */
+#define TRACE_ISR_EXIT		6	/**< id exception number */
+#define TRACE_FIFO_PUT		7	/**< id thread (TRACE_ID_ISR from ISR), arg items */
+#define TRACE_FIFO_GET		8	/**< id thread, arg items */
+#define TRACE_USER			9	/**< free for application */
+#define TRACE_CLOCK			10	/**< bus clock changed, id new clock in MHz, arg old clock in 10 kHz units */
+#define TRACE_PERIODIC_START	11	/**< id periodic thread (add order), inside its timer ISR */
+#define TRACE_PERIODIC_END		12	/**< id periodic thread */
+#define TRACE_ID_ISR		0xFF
+#define TRACE_MAGIC			0x54524345	// "TRCE"
+
+/** TraceEvent
+ * One trace record
+*/
+struct TraceEvent{
+	INT32U time;	/**< OS_Time (1/BUS_CLK units at any bus clock) */
+	INT32U info;	/**< type<<24 | id<<16 | arg */
+};
+typedef struct TraceEvent TraceEventType;
+
+/** TraceLog
+ * Trace ring with header for decoder
+*/
+struct TraceLog{
+	INT32U magic;				/**< TRACE_MAGIC */
+	volatile INT32U writeIdx;	/**< free running count of events recorded */
+	INT32U size;				/**< TRACE_SIZE */
+	INT32U busClock;			/**< timestamp rate (Hz), BUS_CLK since OS_Time does not follow bus clock */
+	TraceEventType events[TRACE_SIZE];
+};
+typedef struct TraceLog TraceLogType;
+
+#if OS_TRACE
+#define OS_TRACE_EVENT(type, id, arg)	OS_TraceEvent(type, id, arg)
+#define OS_TRACE_ISR_ENTER()			OS_TraceEvent(TRACE_ISR_ENTER, OS_ASM_IPSR(), 0)
+#define OS_TRACE_ISR_EXIT()				OS_TraceEvent(TRACE_ISR_EXIT, OS_ASM_IPSR(), 0)
+#define OS_TRACE_FIFO(type, n)			OS_TraceEvent(type, OS_TraceContext(), n)
+#define OS_TRACE_CLOCK(oldClock, newClock)	OS_TraceClock(oldClock, newClock)
+#define OS_TRACE_PERIODIC(type, id)		OS_TraceEvent(type, id, 0)
+#else
+#define OS_TRACE_EVENT(type, id, arg)
+#define OS_TRACE_ISR_ENTER()
+#define OS_TRACE_ISR_EXIT()
+#define OS_TRACE_FIFO(type, n)
+#define OS_TRACE_CLOCK(oldClock, newClock)
+#define OS_TRACE_PERIODIC(type, id)
+#endif
+
+#if OS_CSPROFILE
+// send critical sections of every file that includes OS.h through OSProfile.c,
+// object-like so prototypes in startup.h and OS.c rename to matching ones
+#define StartCritical			OS_CSStart
+#define EndCritical				OS_CSEnd
+#define DisableInterrupts		OS_CSDisable
+#define EnableInterrupts		OS_CSEnable
+#define OS_DisableInterrupts	OS_CSDisable
+#define OS_EnableInterrupts		OS_CSEnable
+#endif
+
+
+/** OS_Init
+ * Initializes operating system, disables interrupts until OS_Launch
+ * Initializes all I/O and interthread communication
+*/
+void OS_Init(void); 
+
+
+/** OS_InitSemaphore
+ * Initializes semaphore to default value sent
+ * @param semaPt pointer to semaphore
+ * @param value value of semaphore
+*/
+void OS_InitSemaphore(Sema4Type *semaPt, INT32 value); 
+
+
+/** OS_Wait
+ * Wait on semaphore, if busy yield
+ * @param semaPt pointer to semaphore
+*/
+void OS_Wait(Sema4Type *semaPt); 
+
+
+/** OS_Signal
+ * Clear Semaphore, Increment
+*/
+void OS_Signal(Sema4Type *semaPt); 
+
+
+/** OS_WaitTimeout
+ * Wait on semaphore, block at most timeout ms
+ * @param semaPt pointer to semaphore
+ * @param timeout max time to block (ms), 0 does not block, OS_WAIT_FOREVER never times out
+ * @return 1 if semaphore taken, 0 if timed out
+*/
+INT8 OS_WaitTimeout(Sema4Type *semaPt, INT32U timeout);
+
+
+/** OS_TryWait
+ * Take semaphore only if free, never blocks (ISR safe)
+ * @param semaPt pointer to semaphore
+ * @return 1 if semaphore taken, 0 if busy
+*/
+INT8 OS_TryWait(Sema4Type *semaPt);
+
+
+/** OS_TryWaitN
+ * Take up to n counts of semaphore that are free, never blocks (ISR safe)
+ * @param semaPt pointer to semaphore
+ * @param n max counts to take
+ * @return number of counts taken
+*/
+INT32U OS_TryWaitN(Sema4Type *semaPt, INT32U n);
+
+
+/** OS_SignalN
+ * Signal semaphore n times in one critical section
+ * @param semaPt pointer to semaphore
+ * @param n number of counts to add
+*/
+void OS_SignalN(Sema4Type *semaPt, INT32U n);
+
+
+/** OS_bWait
+ * @brief Wait on semaphore, binary
+ * @param semaPt pointer to semaphore
+*/
+void OS_bWait(Sema4Type *semaPt); 
+
+
+
+/** OS_bSignal
+ * @brief Signal semaphore to be free, set to 1
+*/
+void OS_bSignal(Sema4Type *semaPt); 
+
+
+/** OS_ASM_Signal
+ * @brief Spinlock semaphore signal using ARM exclusion
+*/
+void OS_ASM_Signal(Sema4Type *semaPt);
+
+
+
+/** OS_ASM_Signal
+ * @brief Spinlock semaphore wait using ARM exclusion
+*/
+void OS_ASM_Wait(Sema4Type *semaPt);
+
+
+/** OS_ASM_IPSR
+ * @brief Active exception number
+ * @return 0 in thread, else exception (IRQ n is n+16)
+*/
+INT32U OS_ASM_IPSR(void);
+
+
+/** OS_ASM_CompareSwap
+ * @brief Lock free compare and swap using ARM exclusion (LDREX/STREX)
+ * @param addr word to update
+ * @param expected value addr must still hold
+ * @param desired new value
+ * @return 1 if swapped, 0 if addr changed
+*/
+INT32U OS_ASM_CompareSwap(volatile INT32U *addr, INT32U expected, INT32U desired);
+
+
+/** OS_AddThread
+ * Add new thread to OS, Linked List style
+ * @param task task to run for thread
+ * @param stackSize size of stack
+ * @param priority priority of thread
+ * @return success: 1, fail: 0
+*/
+INT8 OS_AddThread(void(*task)(void), INT32U priority);
+
+ 
+/** OS_Id
+ * return ID of current thread
+ * @return ID of thread
+*/
+INT32U OS_IdThread(void);
+
+
+/** OS_AddPeriodicThread
+ * Add new thread to OS that runs periodically, first 8 get own hardware timer (Timer1A-Timer4B),
+ * rest become software timers on the 1 ms tick with period rounded to ms, jitter recorded for each
+ * @param task task to run for thread
+ * @param period period in bus cycles
+ * @param priority priority of thread
+ * @return success: 1, fail: 0
+*/
+INT8 OS_AddPeriodicThread(void(*task)(void), INT32U period, INT32U priority);
+
+
+/** OS_PeriodicCount
+ * Number of periodic threads, their ids are 0 to count-1 in order added
+ * @return count
+*/
+INT32U OS_PeriodicCount(void);
+
+
+/** OS_GetJitter
+ * Read jitter stats of periodic thread, deviation is from first activation + n*period
+ * @param id periodic thread id
+ * @param stats output
+ * @return 1 if id valid, 0 if not
+*/
+INT8 OS_GetJitter(INT32U id, JitterType *stats);
+
+
+/** OS_ClearJitter
+ * Reset jitter stats of all periodic threads
+*/
+void OS_ClearJitter(void);
+
+
+
+/** OS_AddSW1Task
+ * Add thread to button PF4
+ * @param task task to run for thread
+ * @param priority priority of thread
+ * @return success: 1, fail: 0
+*/
+INT8 OS_AddSW1Task(void(*task)(void), INT32U priority);
+
+
+/** OS_AddSW1Task
+ * Add thread to button PF0
+ * @param task task to run for thread
+ * @param priority priority of thread
+ * @return success: 1, fail: 0
+*/
+INT8 OS_AddSW2Task(void(*task)(void), INT32U priority);
+
+
+/** OS_Sleep
+ * Put current thread to sleep then yield
+ * @param sleepTime amount of time to sleep (ms)
+*/
+void OS_Sleep(INT32U sleepTime); 
+
+
+/** OS_SleepUntil
+ * Sleep until *lastWake + period so periodic loops keep exact rate, *lastWake is advanced by period
+ * @param lastWake tick of last wake, start with OS_TickCount()
+ * @param period ms between wakes
+ * @return 1 slept, 0 overrun (deadline passed, no sleep), resync with *lastWake = OS_TickCount() if wanted
+*/
+INT8 OS_SleepUntil(INT32U *lastWake, INT32U period);
+
+
+/** OS_TickCount
+ * Return ms ticks since OS_Init, never cleared unlike OS_ReadMsTime
+*/
+INT32U OS_TickCount(void);
+
+
+
+/** OS_GetThreadStats
+ * Read cpu time and context switch counts of thread, updated on every context switch
+ * @param id thread id
+ * @param stats output
+ * @return 1 if thread alive, 0 if not
+*/
+INT8 OS_GetThreadStats(INT32U id, ThreadStatsType *stats);
+
+
+/** OS_Kill
+ * kills current thread
+*/
+void OS_Kill(void); 
+
+
+
+/** OS_Suspend
+ * Suspends current thread
+*/
+void OS_Suspend(void);
+ 
+
+
+/** OS_Fifo_Init
+ * Initialize OS Fifo, size must be power of 2, inits semaphores
+*/
+void OS_Fifo_Init(void);
+
+
+
+/** OS_Fifo_Put
+ * Put data to Fifo, never blocks (ISR safe)
+ * @param data data to put in Fifo
+ * @return success: 1, fail: 0 (full, counted in OS_Fifo_Dropped)
+*/
+INT8 OS_Fifo_Put(FIFO_t data);  
+
+
+/** OS_Fifo_PutTimeout
+ * Put data to Fifo, blocks while full (foreground threads only)
+ * @param data data to put in Fifo
+ * @param timeout max time to block (ms)
+ * @return success: 1, fail: 0 (timed out, counted in OS_Fifo_Dropped)
+*/
+INT8 OS_Fifo_PutTimeout(FIFO_t data, INT32U timeout);
+
+
+
+/** OS_Fifo_PutN
+ * Put block of data to Fifo, never blocks (ISR safe)
+ * @param data data to put in Fifo
+ * @param n number of items
+ * @return number of items put, rest counted in OS_Fifo_Dropped
+*/
+INT32U OS_Fifo_PutN(const FIFO_t *data, INT32U n);
+
+
+/** OS_Fifo_Get
+ * Get data from thread
+ * @return data
+*/
+FIFO_t OS_Fifo_Get(void);
+
+
+/** OS_Fifo_GetN
+ * Get block of data, blocks until at least one item
+ * @param data where to copy data
+ * @param n max number of items
+ * @return number of items copied
+*/
+INT32U OS_Fifo_GetN(FIFO_t *data, INT32U n);
+
+
+
+/** OS_Fifo_Size
+ * Get number of items in FiFo
+ * @return size of Fifo
+*/
+INT32U OS_Fifo_Size(void);
+
+
+/** OS_Fifo_Dropped
+ * Get number of items lost because Fifo was full
+ * @return dropped count
+*/
+INT32U OS_Fifo_Dropped(void);
+
+
+/** OS_QueueInit
+ * Init queue when caller also owns the control block
+ * @param queue queue control block
+ * @param buf storage for queue, must hold depth*itemSize bytes
+ * @param itemSize size of each item in bytes
+ * @param depth max number of items
+*/
+void OS_QueueInit(QueueType *queue, void *buf, INT32U itemSize, INT32U depth);
+
+
+/** OS_QueueCreate
+ * Create message queue using caller storage
+ * @param buf storage for queue, must hold depth*itemSize bytes
+ * @param itemSize size of each item in bytes
+ * @param depth max number of items
+ * @return queue handle, 0 if no queues left (see NUMQUEUES)
+*/
+QueueType* OS_QueueCreate(void *buf, INT32U itemSize, INT32U depth);
+
+
+/** OS_QueuePut
+ * Copy item into queue, blocks if queue full
+ * @param queue queue handle
+ * @param item pointer to item to copy in
+*/
+void OS_QueuePut(QueueType *queue, const void *item);
+
+
+/** OS_QueuePutN
+ * Copy block of items into queue, blocks until all are in
+ * @param queue queue handle
+ * @param items pointer to items to copy in
+ * @param n number of items
+*/
+void OS_QueuePutN(QueueType *queue, const void *items, INT32U n);
+
+
+/** OS_QueuePutTimeout
+ * Copy item into queue, blocks while full until timeout (foreground threads only)
+ * @param queue queue handle
+ * @param item pointer to item to copy in
+ * @param timeout max time to block (ms)
+ * @return 1 if put, 0 if timed out (counted as dropped)
+*/
+INT8 OS_QueuePutTimeout(QueueType *queue, const void *item, INT32U timeout);
+
+
+/** OS_QueueTryPut
+ * Copy item into queue if there is room, never blocks (ISR safe)
+ * @param queue queue handle
+ * @param item pointer to item to copy in
+ * @return 1 if put, 0 if full (counted as dropped)
+*/
+INT8 OS_QueueTryPut(QueueType *queue, const void *item);
+
+
+/** OS_QueueTryPutN
+ * Copy as many items as fit into queue, never blocks (ISR safe)
+ * @param queue queue handle
+ * @param items pointer to items to copy in
+ * @param n number of items
+ * @return number of items put, rest counted as dropped
+*/
+INT32U OS_QueueTryPutN(QueueType *queue, const void *items, INT32U n);
+
+
+/** OS_QueueGet
+ * Copy item out of queue, blocks if queue empty
+ * @param queue queue handle
+ * @param item pointer to copy item to
+*/
+void OS_QueueGet(QueueType *queue, void *item);
+
+
+/** OS_QueueGetN
+ * Copy up to n items out of queue, blocks until at least one
+ * @param queue queue handle
+ * @param items pointer to copy items to
+ * @param n max number of items
+ * @return number of items copied
+*/
+INT32U OS_QueueGetN(QueueType *queue, void *items, INT32U n);
+
+
+/** OS_QueueSize
+ * Get number of items in queue
+ * @param queue queue handle
+ * @return number of items
+*/
+INT32U OS_QueueSize(QueueType *queue);
+
+
+/** OS_QueueDropped
+ * Get number of items lost because queue was full
+ * @param queue queue handle
+ * @return dropped count
+*/
+INT32U OS_QueueDropped(QueueType *queue);
+
+
+/** OS_PriQueueInit
+ * Init priority queue using caller storage
+ * @param queue priority queue
+ * @param buf storage, must hold depth*PRIQUEUE_SLOT_SIZE(itemSize) bytes
+ * @param itemSize size of each item in bytes
+ * @param depth max number of items
+*/
+void OS_PriQueueInit(PriQueueType *queue, void *buf, INT32U itemSize, INT32U depth);
+
+
+/** OS_PriQueuePut
+ * Copy item into queue behind items of same priority, blocks if full
+ * @param queue priority queue
+ * @param item pointer to item
+ * @param priority 0 (highest) to PRIORITYLEVELS-1
+*/
+void OS_PriQueuePut(PriQueueType *queue, const void *item, INT32U priority);
+
+
+/** OS_PriQueueTryPut
+ * Copy item into queue if there is room, never blocks (ISR safe)
+ * @param queue priority queue
+ * @param item pointer to item
+ * @param priority 0 (highest) to PRIORITYLEVELS-1
+ * @return 1 if put, 0 if full
+*/
+INT8 OS_PriQueueTryPut(PriQueueType *queue, const void *item, INT32U priority);
+
+
+/** OS_PriQueuePutFront
+ * Urgent send, item is the next one out ahead of everything queued, blocks if full
+ * @param queue priority queue
+ * @param item pointer to item
+*/
+void OS_PriQueuePutFront(PriQueueType *queue, const void *item);
+
+
+/** OS_PriQueueGet
+ * Copy highest priority item out, blocks if empty
+ * @param queue priority queue
+ * @param item where to copy item
+ * @return priority of item
+*/
+INT32U OS_PriQueueGet(PriQueueType *queue, void *item);
+
+
+/** OS_PriQueueSize
+ * Get number of items in priority queue
+ * @param queue priority queue
+ * @return number of items
+*/
+INT32U OS_PriQueueSize(PriQueueType *queue);
+
+
+/** OS_MsgSend
+ * Send block from a pool through queue without copying it,
+ * sender must not touch block after this, receiver frees it
+ * @param queue queue created with itemSize sizeof(void*)
+ * @param block block from OS_PoolAlloc
+*/
+void OS_MsgSend(QueueType *queue, void *block);
+
+
+/** OS_MsgRecv
+ * Receive block sent with OS_MsgSend, blocks if queue empty,
+ * receiver owns block and must OS_PoolFree it when done
+ * @param queue queue created with itemSize sizeof(void*)
+ * @return block
+*/
+void* OS_MsgRecv(QueueType *queue);
+
+
+/** OS_PoolCreate
+ * Create fixed size block pool using caller storage
+ * @param buf storage, must hold numBlocks blocks of blockSize rounded up to 4 bytes
+ * @param blockSize size of each block in bytes
+ * @param numBlocks number of blocks
+ * @return pool handle, 0 if no pools left (see NUMPOOLS)
+*/
+PoolType* OS_PoolCreate(void *buf, INT32U blockSize, INT32U numBlocks);
+
+
+/** OS_PoolAlloc
+ * Take block from pool, never blocks (ISR safe)
+ * @param pool pool handle
+ * @return block, 0 if pool empty
+*/
+void* OS_PoolAlloc(PoolType *pool);
+
+
+/** OS_PoolAllocTimeout
+ * Take block from pool, blocks while pool empty (foreground threads only)
+ * @param pool pool handle
+ * @param timeout max time to block (ms), OS_WAIT_FOREVER never times out
+ * @return block, 0 if timed out
+*/
+void* OS_PoolAllocTimeout(PoolType *pool, INT32U timeout);
+
+
+/** OS_PoolFree
+ * Give block back to pool (ISR safe)
+ * @param pool pool block came from
+ * @param block block to free
+*/
+void OS_PoolFree(PoolType *pool, void *block);
+
+
+/** OS_PoolGetStats
+ * Read usage of pool
+ * @param pool pool handle
+ * @param stats filled in with snapshot
+*/
+void OS_PoolGetStats(PoolType *pool, PoolStatsType *stats);
+
+
+/** OS_TopicInit
+ * Initialize topic using caller storage
+ * @param topic topic
+ * @param buf storage, must hold depth*itemSize bytes
+ * @param itemSize size of each item in bytes
+ * @param depth number of items kept for slow readers, power of 2
+*/
+void OS_TopicInit(TopicType *topic, void *buf, INT32U itemSize, INT32U depth);
+
+
+/** OS_TopicSubscribe
+ * Attach reader to topic, it sees items published from now on
+ * @param topic topic
+ * @param sub subscriber owned by the reader
+*/
+void OS_TopicSubscribe(TopicType *topic, SubscriberType *sub);
+
+
+/** OS_TopicPublish
+ * Write item once for all subscribers, never blocks (ISR safe)
+ * @param topic topic
+ * @param item pointer to item
+*/
+void OS_TopicPublish(TopicType *topic, const void *item);
+
+
+/** OS_TopicRead
+ * Read next item for this subscriber, never blocks
+ * @param sub subscriber
+ * @param item where to copy item
+ * @return 1 if item read, 0 if nothing new
+*/
+INT8 OS_TopicRead(SubscriberType *sub, void *item);
+
+
+/** OS_TopicReceive
+ * Read next item for this subscriber, blocks until one is published
+ * @param sub subscriber
+ * @param item where to copy item
+*/
+void OS_TopicReceive(SubscriberType *sub, void *item);
+
+
+/** OS_StreamInit
+ * Initialize stream buffer using caller storage
+ * @param stream stream
+ * @param buf storage
+ * @param size size of storage in bytes, power of 2
+ * @param trigger default bytes needed to wake reader, at least 1
+*/
+void OS_StreamInit(StreamType *stream, void *buf, INT32U size, INT32U trigger);
+
+
+/** OS_StreamWrite
+ * Copy bytes into stream, never blocks (ISR safe)
+ * @param stream stream
+ * @param data bytes to write
+ * @param n number of bytes
+ * @return number of bytes written, less than n if stream full
+*/
+INT32U OS_StreamWrite(StreamType *stream, const void *data, INT32U n);
+
+
+/** OS_StreamRead
+ * Read bytes from stream, blocks until minBytes are available or timeout
+ * @param stream stream
+ * @param data where to copy bytes
+ * @param max max number of bytes to read
+ * @param minBytes bytes to wait for, 0 uses trigger level
+ * @param timeout max time to block (ms), OS_WAIT_FOREVER never times out
+ * @return number of bytes read, may be less than minBytes on timeout
+*/
+INT32U OS_StreamRead(StreamType *stream, void *data, INT32U max, INT32U minBytes, INT32U timeout);
+
+
+/** OS_StreamAvailable
+ * Get number of bytes in stream
+ * @param stream stream
+ * @return bytes available to read
+*/
+INT32U OS_StreamAvailable(StreamType *stream);
+
+
+/** OS_StreamSpace
+ * Get free space in stream
+ * @param stream stream
+ * @return bytes that can be written
+*/
+INT32U OS_StreamSpace(StreamType *stream);
+
+
+/** OS_DeferInit
+ * @brief Empty deferred work queue and add its worker thread, called by OS_Init
+*/
+void OS_DeferInit(void);
+
+
+/** OS_Defer
+ * Queue work for DEFER_PRIORITY worker thread, for ISRs to push heavy work out
+ * Queue is lock free but waking the worker uses OS_Signal, so only call from threads
+ * and ISRs at or below OS_MAX_SYSCALL_PRIORITY
+ * @param fn function to run, may use OS calls but should not block long
+ * @param arg passed to fn
+ * @return 1 queued, 0 queue full (see DEFER_SIZE)
+*/
+INT8 OS_Defer(void(*fn)(void *arg), void *arg);
+
+
+/** OS_DeferDropped
+ * @return number of work items dropped because queue was full
+*/
+INT32U OS_DeferDropped(void);
+
+
+/** OS_WorkPoolInit
+ * @brief Empty job queue and add NUMWORKERS pool threads, called by OS_Init
+*/
+void OS_WorkPoolInit(void);
+
+
+/** OS_JobSubmit
+ * Queue job for worker pool instead of adding a thread per event, never blocks
+ * Safe from threads and ISRs at or below OS_MAX_SYSCALL_PRIORITY
+ * @param fn function to run, may sleep or block
+ * @param arg passed to fn
+ * @param priority 0 (runs first) to PRIORITYLEVELS-1
+ * @return 1 queued, 0 queue full (see JOB_DEPTH)
+*/
+INT8 OS_JobSubmit(void(*fn)(void *arg), void *arg, INT32U priority);
+
+
+/** OS_JobsPending
+ * @return number of jobs waiting for a worker
+*/
+INT32U OS_JobsPending(void);
+
+
+/** OS_JobsDropped
+ * @return number of jobs dropped because queue was full
+*/
+INT32U OS_JobsDropped(void);
+
+
+/** OS_TimerServiceInit
+ * @brief Empty timing wheel, called by OS_Init
+*/
+void OS_TimerServiceInit(void);
+
+
+/** OS_WheelTick
+ * @brief Advance timing wheel 1 ms and run expired timers, called by OS_SleepHandler
+*/
+void OS_WheelTick(void);
+
+
+/** OS_WheelAdd
+ * @brief Arm wheel timer, kernel use with interrupts off
+ * @param timer timer with expireFn set, not armed
+ * @param ticks ms from now, at least 1
+*/
+void OS_WheelAdd(TimerType *timer, INT32U ticks);
+
+
+/** OS_WheelRemove
+ * @brief Disarm wheel timer if armed, kernel use with interrupts off
+ * @param timer timer
+*/
+void OS_WheelRemove(TimerType *timer);
+
+
+/** OS_TimerCreate
+ * Setup software timer, starts stopped
+ * @param timer caller storage, must stay valid while timer used
+ * @param callback run by deferred work thread (OS_Defer) after expire
+ * @param period ms between expires, also first delay
+ * @param periodic 1 periodic, 0 one-shot
+*/
+void OS_TimerCreate(TimerType *timer, void(*callback)(void), INT32U period, INT8U periodic);
+
+
+/** OS_TimerStart
+ * Arm timer one period from now, restarts if already armed
+ * @param timer timer
+*/
+void OS_TimerStart(TimerType *timer);
+
+
+/** OS_TimerStop
+ * Disarm timer
+ * @param timer timer
+*/
+void OS_TimerStop(TimerType *timer);
+
+
+/** OS_TimerChangePeriod
+ * Change period, armed timer restarts with new period
+ * @param timer timer
+ * @param period new period in ms
+*/
+void OS_TimerChangePeriod(TimerType *timer, INT32U period);
+
+
+/** OS_TimerIsActive
+ * @param timer timer
+ * @return 1 armed, 0 stopped
+*/
+INT8 OS_TimerIsActive(TimerType *timer);
+
+
+/** OS_TraceInit
+ * @brief Empty trace ring, called by OS_Init when OS_TRACE
+*/
+void OS_TraceInit(void);
+
+
+/** OS_TraceEvent
+ * Record trace event, lock free, threads and ISRs, use OS_TRACE_EVENT so it compiles out
+ * @param type TRACE_* type
+ * @param id 8 bit id
+ * @param arg 16 bit data
+*/
+void OS_TraceEvent(INT32U type, INT32U id, INT32U arg);
+
+
+/** OS_TraceClock
+ * Record bus clock change, called by OS_SetBusClock, timestamps keep their unit
+ * @param oldClock clock before change (Hz)
+ * @param newClock clock from now on (Hz)
+*/
+void OS_TraceClock(INT32U oldClock, INT32U newClock);
+
+
+/** OS_CSStart
+ * StartCritical that times the section, StartCritical maps here when OS_CSPROFILE
+ * @return previous BASEPRI, pass to OS_CSEnd
+*/
+INT32U OS_CSStart(void);
+
+
+/** OS_CSEnd
+ * EndCritical that records section length against call site of OS_CSStart
+ * @param sr from OS_CSStart
+*/
+void OS_CSEnd(INT32U sr);
+
+
+/** OS_CSDisable
+ * DisableInterrupts that starts timing if interrupts were on
+*/
+void OS_CSDisable(void);
+
+
+/** OS_CSEnable
+ * EnableInterrupts that records section started by OS_CSDisable or OS_CSStart
+*/
+void OS_CSEnable(void);
+
+
+/** OS_CSWorst
+ * Copy profiled call sites, longest section first
+ * @param out array of max entries
+ * @param max size of out
+ * @return entries copied
+*/
+INT32U OS_CSWorst(CritStatsType *out, INT32U max);
+
+
+/** OS_CSClear
+ * Reset critical section and wake-to-run statistics
+*/
+void OS_CSClear(void);
+
+
+/** OS_TraceContext
+ * @return current thread id, TRACE_ID_ISR in ISR
+*/
+INT32U OS_TraceContext(void);
+
+
+extern TraceLogType OS_TraceLog;
+
+
+/** OS_HeapInit
+ * @brief Set heap to one free block, called by OS_Init
+*/
+void OS_HeapInit(void);
+
+
+/** OS_Malloc
+ * Allocate from TLSF heap in bounded time, threads only (uses kernel lock)
+ * @param size bytes needed
+ * @return pointer to 8 byte aligned memory, 0 if no fit
+*/
+void* OS_Malloc(INT32U size);
+
+
+/** OS_Free
+ * Give memory back to heap in bounded time, threads only
+ * @param ptr memory from OS_Malloc, 0 is ignored
+*/
+void OS_Free(void *ptr);
+
+
+/** OS_HeapGetStats
+ * Read heap usage and fragmentation, walks arena so not real time
+ * @param stats filled in with snapshot
+*/
+void OS_HeapGetStats(HeapStatsType *stats);
+
+
+/** OS_ArenaAttach
+ * Give current thread a scratch arena taken from a pool (block size is arena size)
+ * @param pool pool to take arena from
+ * @return 1 if attached, 0 if pool empty
+*/
+INT8 OS_ArenaAttach(PoolType *pool);
+
+
+/** OS_ArenaAlloc
+ * Bump pointer allocation from current thread arena, no locking
+ * @param size bytes needed
+ * @return 8 byte aligned memory, 0 if arena full or not attached
+*/
+void* OS_ArenaAlloc(INT32U size);
+
+
+/** OS_ArenaReset
+ * Free all allocations from current thread arena at once, e.g. end of frame
+*/
+void OS_ArenaReset(void);
+
+
+/** OS_ArenaDetach
+ * Return current thread arena to its pool, also done by OS_Kill
+*/
+void OS_ArenaDetach(void);
+
+
+/** OS_MailBox_Init
+ * @brief Initialize mailbox for OS
+*/
+void OS_MailBox_Init(void);
+
+
+/** OS_MailBox_Send
+ * Puts data in mailbox
+ * @param data
+*/
+void OS_MailBox_Send(INT32U data);
+
+
+/** OS_MailBox_Recv
+ * Get data from Mailbox
+ * @return data
+*/
+INT32U OS_MailBox_Recv(void);
+
+
+/** OS_MailBoxInit
+ * @brief Initialize mailbox object owned by the application
+ * @param box mailbox
+ * @param mode MAILBOX_BLOCKING or MAILBOX_OVERWRITE
+*/
+void OS_MailBoxInit(MailBoxType *box, INT8U mode);
+
+
+/** OS_MailBoxSend
+ * Puts data in mailbox, blocks until old data received unless overwrite mode
+ * (overwrite mode is ISR safe)
+ * @param box mailbox
+ * @param data
+*/
+void OS_MailBoxSend(MailBoxType *box, INT32U data);
+
+
+/** OS_MailBoxRecv
+ * Get data from mailbox, blocks until there is new data
+ * @param box mailbox
+ * @return data (latest value in overwrite mode)
+*/
+INT32U OS_MailBoxRecv(MailBoxType *box);
+
+
+/** OS_Time
+ * Returns time in 1/BUS_CLK (12.5ns) units, wraps every 53 s, use OS_Time64 for longer spans
+ * Unit does not change with OS_SetBusClock, cycles are converted, so differences,
+ * jitter, thread and profiler stats stay valid across clock changes (OS_TIME_1MS per ms)
+*/
+INT32U OS_Time(void);
+
+
+/** OS_BusClock
+ * Returns current bus clock in Hz, TIME_1MS follows it
+*/
+INT32U OS_BusClock(void);
+
+
+/** OS_SetBusClock
+ * Change bus clock at runtime (PLL divider), rescales SysTick, hardware timers, UART baud and periodic threads
+ * Periods passed to OS_AddPeriodicThread are in bus cycles of clock at time of call
+ * Threads only, waits for UART TX to drain first
+ * @param sysdiv divider from PLL.h (Bus80MHz, Bus16MHz, ...)
+ * @return new bus clock in Hz, 0 if sysdiv invalid or time slice would not fit 24 bit SysTick
+*/
+INT32U OS_SetBusClock(INT32U sysdiv);
+
+
+/** OS_PeriodicRescale
+ * Restart periodic thread ideal times after clock change, called by OS_SetBusClock
+*/
+void OS_PeriodicRescale(void);
+
+
+/** OS_Time64
+ * Returns monotonic time since OS_Init in 1/BUS_CLK (12.5ns) units at any bus clock, safe from threads and ISRs
+*/
+INT64U OS_Time64(void);
+
+
+/** OS_TimeDifference
+ * Return difference between time
+ * @param start start time
+ * @param stop stop time
+ * @return time difference
+*/
+INT32U OS_TimeDifference(INT32U start, INT32U stop);
+
+
+/** OS_ClearMsTime
+ * clear ms time counter
+*/
+void OS_ClearMsTime(void);
+
+
+/** OS_ReadMsTime
+ * return time (ms)
+ * @return time in ms
+*/
+INT32U OS_ReadMsTime(void);
+
+
+/** OS_Launch
+ * Start OS, setup SysTick 
+ * @param theTimeSlice Time between context switches
+*/
+void OS_Launch(INT32U theTimeSlice);
+
+
+/** OS_ClearMsTime
+ * The following function clears the period time, resets counter
+ * @returns 1 if success
+ */
+void OS_ClearMsTime(void);
+
+
+
+
+
+#endif // _OS_H_
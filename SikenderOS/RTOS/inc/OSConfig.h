@@ -1,56 +1,146 @@
-/**
-* @file OSConfig.h
-* @brief Configuration setup for OS
-* @date 2/04/2019
-*/
-#ifndef __OSCONFIG_H
-#define __OSCONFIG_H  
-
-#include "cpu_vars.h"
-
-
-// edit these depending on your clock  
-#define TIME_1MS    BUS_CLK/1000
-#define TIME_2MS    (2*TIME_1MS)  
-#define TIME_500US  (TIME_1MS/2)  
-#define TIME_250US  (TIME_1MS/5)  
-#define PERIOD TIME_500US
-
-
-//***************** OS CONFIGURATION **********************/
-/** NUMTHREADS
- * @brief max number of threads
-*/
-#define NUMTHREADS  10        
-
-/** STACKSIZE
- * @brief max size of stack
-*/
-#define STACKSIZE   256       
-
-/** PRIORITYLEVELS
- * @brief number of priorities
-*/
-#define PRIORITYLEVELS 8       // 0-7, priority follows ARM interrupt protocol
-
-/**
- * OS FIFO SIZE
- * @brief Size of OS FIFO in 32 bit words
- */
-#define FIFO_SIZE 256
-
-typedef INT32 FIFO_t; 
-
-
-/**
- * OS Scheduler Mode
- * @brief Set mode of scheduler,
- * 			1: Priority Scheduler (Blocking semaphores)
- *			0: Round Robin Scheduler (Spin-Lock semaphores)
- */
-#define SCHEDULER_MODE 1
-
-
-
-#endif //_OSConfig_H
-
+/**
+* @file OSConfig.h
+* @brief Configuration setup for OS
+* @date 2/04/2019
+*/
+#ifndef __OSCONFIG_H
+#define __OSCONFIG_H  
+
+#include "cpu_vars.h"
+
+
+// follow current bus clock (OS_SetBusClock), BUS_CLK is clock at boot
+#define TIME_1MS    (OS_BusClock()/1000)
+#define TIME_2MS    (2*TIME_1MS)  
+#define TIME_500US  (TIME_1MS/2)  
+#define TIME_250US  (TIME_1MS/5)  
+#define PERIOD TIME_500US
+
+// OS_Time units, fixed 1/BUS_CLK whatever bus clock is now
+#define OS_TIME_1MS	(BUS_CLK/1000)
+
+
+//***************** OS CONFIGURATION **********************/
+/** NUMTHREADS
+ * @brief max number of threads
+*/
+#define NUMTHREADS  10        
+
+/** STACKSIZE
+ * @brief max size of stack
+*/
+#define STACKSIZE   256       
+
+/** PRIORITYLEVELS
+ * @brief number of priorities
+*/
+#define PRIORITYLEVELS 8       // 0-7, priority follows ARM interrupt protocol
+
+/**
+ * OS_MAX_SYSCALL_PRIORITY
+ * @brief most urgent NVIC priority (0-7) allowed to call OS, critical sections only mask
+ *			this and lower, ISRs above it (numerically smaller) are never delayed by kernel
+ *			but must not call any OS function
+ *			Timer0A tick runs at this level, keep at 2 or less for UART0
+ */
+#define OS_MAX_SYSCALL_PRIORITY 1
+
+/**
+ * OS FIFO SIZE
+ * @brief Size of OS FIFO in 32 bit words
+ */
+#define FIFO_SIZE 256
+
+typedef INT32 FIFO_t; 
+
+/**
+ * NUMQUEUES
+ * @brief max number of message queues from OS_QueueCreate
+ */
+#define NUMQUEUES 8
+
+/**
+ * DEFER_SIZE
+ * @brief work items OS_Defer can hold before dropping, power of 2
+ */
+#define DEFER_SIZE 32
+
+/**
+ * DEFER_PRIORITY
+ * @brief thread priority of deferred work worker, takes one of NUMTHREADS
+ */
+#define DEFER_PRIORITY 0
+
+/**
+ * NUMWORKERS
+ * @brief threads in job worker pool (OS_JobSubmit), each takes one of NUMTHREADS
+ */
+#define NUMWORKERS 2
+
+/**
+ * WORKER_PRIORITY
+ * @brief thread priority of pool workers
+ */
+#define WORKER_PRIORITY 1
+
+/**
+ * JOB_DEPTH
+ * @brief jobs that can wait for a worker before OS_JobSubmit drops
+ */
+#define JOB_DEPTH 16
+
+/**
+ * NUMPOOLS
+ * @brief max number of fixed block pools from OS_PoolCreate
+ */
+#define NUMPOOLS 4
+
+/**
+ * HEAP_SIZE
+ * @brief bytes in arena for OS_Malloc/OS_Free (TLSF heap), multiple of 8, under 128K
+ */
+#define HEAP_SIZE 4096
+
+/**
+ * JITTER_BUCKETS
+ * @brief log2 buckets in periodic thread jitter histogram, 16 covers up to 16K bus cycles
+ */
+#define JITTER_BUCKETS 16
+
+/**
+ * OS_TRACE
+ * @brief 1 records scheduler, semaphore, ISR and FIFO events into OS_TraceLog, 0 compiles them out
+ */
+#define OS_TRACE 0
+
+/**
+ * TRACE_SIZE
+ * @brief events kept in trace ring (8 bytes each), power of 2
+ */
+#define TRACE_SIZE 256
+
+/**
+ * OS_CSPROFILE
+ * @brief 1 times every critical section and wake-to-run latency (OSProfile.c), 0 compiles it out
+ */
+#define OS_CSPROFILE 0
+
+/**
+ * CS_SITES
+ * @brief call sites kept by critical section profiler, extra sites are lumped into last entry
+ */
+#define CS_SITES 16
+
+
+/**
+ * OS Scheduler Mode
+ * @brief Set mode of scheduler,
+ * 			1: Priority Scheduler (Blocking semaphores)
+ *			0: Round Robin Scheduler (Spin-Lock semaphores)
+ */
+#define SCHEDULER_MODE 1
+
+
+
+#endif //_OSConfig_H
+
@@ -1,26 +1,26 @@
-/**
-* @file cpu_vars.h
-* @brief Contains CPU/Compilter variables
-* @date 6/19/2018
-*/
-
-#ifndef __CPU_VARS_H
-#define __CPU_VARS_H
-
-#include <stdint.h>
-
-
-typedef uint8_t		INT8U;
-typedef uint16_t	INT16U;
-typedef uint32_t 	INT32U;
-typedef uint64_t	INT64U;
-typedef int8_t		INT8;
-typedef int16_t		INT16;
-typedef int32_t 	INT32;
-typedef int64_t		INT64;
-typedef char		CHAR;
-
-
-
-#endif // __CPU_VARS_H
-
+/**
+* @file cpu_vars.h
+* @brief Contains CPU/Compilter variables
+* @date 6/19/2018
+*/
+
+#ifndef __CPU_VARS_H
+#define __CPU_VARS_H
+
+#include <stdint.h>
+
+
+typedef uint8_t		INT8U;
+typedef uint16_t	INT16U;
+typedef uint32_t 	INT32U;
+typedef uint64_t	INT64U;
+typedef int8_t		INT8;
+typedef int16_t		INT16;
+typedef int32_t 	INT32;
+typedef int64_t		INT64;
+typedef char		CHAR;
+
+
+
+#endif // __CPU_VARS_H
+
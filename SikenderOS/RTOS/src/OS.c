@@ -1,770 +1,1297 @@
-/**
-* @file OS.c
-* @brief Contains functions to run OS
-* 
-*/
-#include "cpu.h"
-#include "startup.h"
-#include "Timer.h"
-#include "Switch.h"
-#include "OS.h"
-
-
-// OS ASM functions
-void StartOS(void);
-void OS_EnableInterrupts(void);
-void OS_DisableInterrupts(void);
-
-
-/*! @var INT32U Stacks
-    @brief Contains all the stacks for each thread
-*/
-static INT32U Stacks[NUMTHREADS][STACKSIZE];
-
-/*! @var INT8U numOfThreads
-    @brief number of threads running
-*/
-static INT32U NumOfThreads = 0;
-
-/*! @var uint32_T OS_SystemTime
-    @brief time OS has been running in ms
-*/
-static INT64U OS_SystemTime = 0;
-
-/*! @var uint32_T OS_SystemTimeMS
-    @brief time OS has been running in ms
-*/
-static INT64U OS_SystemTimeMS;
-
-/*! @var MailBoxType MailBox
-	@brief mailbox variable defined for OS mailbox
-*/
-static MailBoxType MailBox;
-
-
-/** @var Thread Control Block
- * @brief Structure for each thread, helps with context switching, Now Doubly linked List
-*/
-struct Tcb{
-	/*@{*/
-	INT32U *sp;			/**< pointer to stack (valid for threads not running */
-	// double LL
-	struct Tcb* next;		/**< Pointer to next TCB */
-	struct Tcb* prev;
-	// basic properties
-	INT32 id;					/**< ID number of thread, negative if unused */
-	INT32 status;				/**< status of thread: -1: unused, 1: used */
-	INT8U priority;		/**< priority of thread, 0-5 */
-	INT32U sleepState;		/**< sleep state */
-	// Lab 3 blocking threads
-	Sema4Type* sema4Blocked;	/**< blocked state */
-	struct Tcb* nextBlocked;
-	struct Tcb* nextPriority;
-	/*@}*/
-};
-typedef struct Tcb tcbType;
-static tcbType tcbs[NUMTHREADS];
-
-/*! @var tcbType *RunPt
-    @brief Contains currently running thread 
-*/
-tcbType *RunPt;
-
-/*! @var tcbType *NextRunPt
-    @brief Contains next thread to run
-*/
-tcbType *NextRunPt;
-
-/*! @var FIFO_t OS_FIFO
-    @brief Contains next thread to run
-*/
-static FIFO_t OS_FIFO[FIFO_SIZE];
-static INT32U Get_Idx = 0, Put_Idx = 0;
-static Sema4Type SemaFIFO;
-
-//************* PRIORITY SCHEDULING GLOBALS AND ARRAYS**************************************************************************
-//Value > 0, else 0 if empty, change upon OS_Kill, Total number of threads in priority level
-INT32 PriorityTotal[PRIORITYLEVELS] 		= {0};		
-// Array to skip threads if threas sleep/block, if 0 move to next thread, Avaliable priorities to run
-INT32 PriorityAvailable[PRIORITYLEVELS] 	= {0};
-// LL for each priority level 
-tcbType* PriorityPtr[PRIORITYLEVELS] 		= {0};	
-// Pointer to end of LL
-tcbType* PriorityLastPtr[PRIORITYLEVELS] 	= {0};
-
-//*********************************************** Basic OS Initilization Functions ********************
-//*********************************************** Add CPU/Peripheral Functions to these if desired ********************
-
-/** SetInitialStack
- *	@brief sets stack to default values
- * @param i tcb thread number
- * 
-*/
-static void SetInitialStack(INT32U i){
-  tcbs[i].sp = &Stacks[i][STACKSIZE-16]; // thread stack pointer
-  Stacks[i][STACKSIZE-1] = 0x01000000;   // thumb bit
-  Stacks[i][STACKSIZE-3] = 0x14141414;   // R14
-  Stacks[i][STACKSIZE-4] = 0x12121212;   // R12
-  Stacks[i][STACKSIZE-5] = 0x03030303;   // R3
-  Stacks[i][STACKSIZE-6] = 0x02020202;   // R2
-  Stacks[i][STACKSIZE-7] = 0x01010101;   // R1
-  Stacks[i][STACKSIZE-8] = 0x00000000;   // R0
-  Stacks[i][STACKSIZE-9] = 0x11111111;   // R11
-  Stacks[i][STACKSIZE-10] = 0x10101010;  // R10
-  Stacks[i][STACKSIZE-11] = 0x09090909;  // R9
-  Stacks[i][STACKSIZE-12] = 0x08080808;  // R8
-  Stacks[i][STACKSIZE-13] = 0x07070707;  // R7
-  Stacks[i][STACKSIZE-14] = 0x06060606;  // R6
-  Stacks[i][STACKSIZE-15] = 0x05050505;  // R5
-  Stacks[i][STACKSIZE-16] = 0x04040404;  // R4
-}
-
-/** SetThreads
-* @brief Set Threads to default values for unused.
-* 
-*/
-static void SetThreads(void){
-	for (INT8 i = 0; i < NUMTHREADS; i++){
-		tcbs[i].status = -1;
-		tcbs[i].id = -1;
-		tcbs[i].sleepState = 0;
-	}
-	for (INT8 i = 0; i < PRIORITYLEVELS; i++){
-		PriorityPtr[i] = 0;
-	}
-}
-	
-/** OS_SleepHandler
- * @brief Update Sleep timer and run through linked list and remove any sleeping threads
- *  @return none
-*/
-static void OS_SleepHandler(void){
-	// increment timer for sleep
-	OS_SystemTimeMS++;
-	
-	// run through list of threads and decrement sleep counter
-	for(INT32 i=0; i < NUMTHREADS; i++){
-		// check if thread not dead and sleeping
-		if(((tcbs[i].status != -1) && (tcbs[i].sleepState))){
-			tcbs[i].sleepState--;
-			if (tcbs[i].sleepState == 0){
-				PriorityAvailable[tcbs[i].priority]++;
-			}
-		}
-	}
-}
-
-/* OS_SystemTime
- * @brief increment timer, more accurate than 1ms timer
-**/
-void OS_SystemTimeHandler(void){
-	OS_SystemTime++;
-}
-
-/** Peripheral_Init
-* @brief This function initializes extra IO used by OS, add new inits here
-*/
-void Peripheral_Init(void){
-	// 1 ms timer for OS/ sleep decrement
-	Timer0A_Init(&OS_SleepHandler, TIME_1MS, 1);
-	// accurate system timer, optional
-	Timer0B_Init(&OS_SystemTimeHandler, TIME_1MS, 1);
-
-}
-
-/** OS_SystemtPriority
- *	@brief Set priority of Systick and PendSV (Context Switch handlers)
-*/
-void OS_SystemPriority(void){
-	NVIC_SYS_PRI3_R =(NVIC_SYS_PRI3_R&0x00FFFFFF)|0xD0000000; // priority 6
-	NVIC_SYS_PRI3_R =(NVIC_SYS_PRI3_R&0xFF00FFFF)|0x00E00000; // priority 7
-
-}
-
-/** OS_Init
- *	@brief initialize operating system, disable interrupts until OS_Launch
- *	initialize OS controlled I/O: serial, ADC, systick, LaunchPad I/O and timers 
-*/
-void OS_Init(void){
-	OS_DisableInterrupts();
-	Peripheral_Init();
-	OS_SystemTimeMS = 0;
-	OS_SystemTime = 0;
-	SetThreads();
-	OS_SystemPriority();
-	RunPt = &tcbs[0]; 
-}
-
-/** @brief  LinkTCB
- *	Add TCB to doubly Linked List, copy pasta ee 312
-*/
-void LinkTCB(tcbType* newThread){
-	// add to Doubly LL, copy pasta
-	tcbType* endPtr = RunPt->prev;
-	// increment count
-	PriorityAvailable[newThread->priority]++;
-	newThread->next = RunPt;
-	RunPt->prev = newThread;
-	newThread->prev = endPtr;
-	endPtr->next = newThread;
-	
-	//increment thread count
-	NumOfThreads++;
-}
-
-/** @brief  UnLinkTCB
- *	Remove thread form Doubly LL of TCB, copy pasta 
-*/
-void UnLinkTCB(void){
-	//do removal for double LL
-	RunPt->prev->next = RunPt->next;
-	RunPt->next->prev = RunPt->prev;
-	NumOfThreads--;
-}
-
-/** AddBlockedToSema4
- *	@brief Add TCB to blocked Linked list of semaphore
- *  @param semaPt ptr to semaphore
-*/
-void AddBlockedToSemaphore(Sema4Type* semaPt){
-	// go to end of LL to add tcb or add to head, copy pasta
-	if(semaPt->blockThreads == 0){
-		semaPt->blockThreads = RunPt;
-		semaPt->blockThreads->nextBlocked = 0;
-	}else{
-		// go to end
-		tcbType* endPtr = semaPt->blockThreads;
-		while(endPtr->nextBlocked != 0){
-			endPtr = endPtr->nextBlocked;
-		}
-		endPtr->nextBlocked = RunPt;
-		endPtr->nextBlocked->nextBlocked = 0;
-	}
-}
-
-/** RemoveBlockedFromSemaphore
- *	@brief Remove TCB from blocked list, assuiming thread already blocked, else rip program
- *  @param semaPt ptr to semaphore
- *  @return tcb that is no longer blocked from list
-*/
-tcbType* RemoveBlockedFromSemaphore(Sema4Type* semaPt){
-	// copy pasta ee 312, 
-	tcbType* headLink = semaPt->blockThreads;
-	semaPt->blockThreads = headLink->nextBlocked;
-	return headLink;
-}
-
-/** UnBlockTCB
- *	@brief Remove TCB from blocked list
- *  @param semaPt ptr to semaphore
-*/
-void UnBlockTCB(Sema4Type* semaPt){
-	tcbType* blocked = RemoveBlockedFromSemaphore(semaPt);
-	LinkTCB(blocked);
-	blocked->sema4Blocked = 0;
-}
-
-/** BlockTCB
- *	@brief Add current TCB to blocked list then yield, ratatatat
- *  @param semaPt ptr to semaphore
-*/
-void BlockTCB(Sema4Type* semaPt){
-	RunPt->sema4Blocked = semaPt;
-	PriorityAvailable[RunPt->priority]--;
-	UnLinkTCB();
-	AddBlockedToSemaphore(semaPt);
-	OS_Suspend();
-}
-
-/** OS_Launch
-* @brief This function starts the scheduler and enables interrupts
-* @param theTimeSlice period of round robin scheduler
-
-* 
-*/
-void OS_Launch(INT32U theTimeSlice){
-	INT32 pri = 0;
-	for (pri = 0; pri < PRIORITYLEVELS; pri++){
-		if (PriorityAvailable[pri] > 0)
-			break;
-	}
-	
-	RunPt = PriorityPtr[pri];
-	SysTick_Init(theTimeSlice);
-	StartOS();
-}
-
-/** OS_Scheduler
-* @brief This function runs next highest priority thread, PRIORITY SCHEDULER
-*/
-void OS_Scheduler(void){
-	INT32 pri = 0;
-	NextRunPt = RunPt->next;
-	// go through priority list, exit when next highest thread found
-	for (pri = 0; pri < PRIORITYLEVELS; pri++){
-		if (PriorityAvailable[pri] > 0)
-			break;
-	}
-
-	// check if next priority thread is the same priority
-	if (pri == RunPt->priority){	
-		NextRunPt = RunPt->nextPriority;
-		// Ensure next thread not sleeping 
-		while(NextRunPt->sleepState || NextRunPt->sema4Blocked){
-			NextRunPt = NextRunPt->nextPriority;
-		} 
-	// run lower pri task
-	}else{
-		if (pri != PRIORITYLEVELS){
-			NextRunPt = PriorityPtr[pri];
-			// Ensure next thread not sleeping 
-			while(NextRunPt->sleepState || NextRunPt->sema4Blocked){	
-				NextRunPt = NextRunPt->nextPriority;
-			}
-		}
-	}
-	
-}
-
-/** SysTick_Handler
- * @brief This function decides next thread to run
-**/
-void SysTick_Handler(void){
-	OS_Scheduler();
-	//go to pendSV
-	NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV; // go to context switch
-	//PE1 ^= 0x02;
-}
-
-/** OS_Suspend
-* @brief This function suspends current thread by forcing context switch call
-* 
-*/
-void OS_Suspend(void)
-{
-	//OS_Scheduler();
-	//NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV; // go to context switch
-	NVIC_ST_CURRENT_R = 0;      // clear timer
-	NVIC_INT_CTRL_R = 0x04000000; // go to SysTick Handler
-}
-
-/** OS_AddThread
-* @brief This function decides next thread to run, now uses priority scheduler
-* @param newThread
-
-* 
-*/
-void OS_AddPriorityThread(tcbType* newThread){
-	INT32 pri = newThread->priority;
-	
-	// Add head priority task
-	if(PriorityTotal[pri] == 0){
-		PriorityPtr[pri] 		= newThread;
-		PriorityLastPtr[pri] 	= newThread;
-		newThread->nextPriority = newThread;
-	// Add thread to existing LL, put at head so O(1)
-	} else{
-		newThread->nextPriority 			= PriorityLastPtr[pri]->nextPriority;
-		PriorityLastPtr[pri]->nextPriority 	= newThread;
-		PriorityPtr[pri] 					= newThread;
-	}
-	
-	//increment counters
-	PriorityAvailable[pri]++;
-	PriorityTotal[pri]++;
-	
-}
-
-/** OS_AddThread
-* @brief This function decides next thread to run, now uses priority scheduler
-* @param task
-* @param stackSize
-* @param priority
-* @return 1-success, 0-fail
-* 
-*/
-INT8 OS_AddThread(void(*task)(void), INT32U priority){
-	// check if max thread limit reached
-	if(NumOfThreads >= NUMTHREADS){
-		return 0; 
-	}
-	// Start of adding thread
-	INT32U sr = StartCritical();
-	
-	// search for availalbe tcb
-	INT8 idxFreeTCB = 0;
-	for(idxFreeTCB = 0; idxFreeTCB < NUMTHREADS; idxFreeTCB++){
-		//break once found
-		if(tcbs[idxFreeTCB].status == -1){
-			break;
-		}
-	}
-	
-	// check if this is the only thread
-	if(NumOfThreads == 0){
-		tcbs[NumOfThreads].next = &tcbs[0];
-		tcbs[NumOfThreads].prev = &tcbs[0];
-		RunPt = &tcbs[0];
-		tcbs[0].priority = priority;
-	}
-	// add thread, treat like linked list, (code from EE312)
-	else{ 
-		if(RunPt->status == -1 || idxFreeTCB >= NUMTHREADS){
-			EndCritical(sr);
-			return 0;
-		}
-		
-		//insertion for doubly linked list
-		tcbType* endPtr = RunPt->prev; 
-		tcbs[idxFreeTCB].next = RunPt;		
-		RunPt->prev = &tcbs[idxFreeTCB];
-		tcbs[idxFreeTCB].prev = endPtr;
-		endPtr->next = &tcbs[idxFreeTCB];
-	}
-	//init stack and add task to TCB
-	SetInitialStack(idxFreeTCB);
-	Stacks[idxFreeTCB][STACKSIZE-2] = (INT32)(task); // PC
-	
-	// init vars of tcb
-	tcbs[idxFreeTCB].sleepState = 0;
-	tcbs[idxFreeTCB].status = 0; 
-	tcbs[idxFreeTCB].id = idxFreeTCB;
-	tcbs[idxFreeTCB].priority = priority;
-	
-	//increment thread count
-	NumOfThreads++;
-	
-	// Go to Priority Scheduler addition
-	OS_AddPriorityThread(&tcbs[idxFreeTCB]);
-	EndCritical(sr);
-	// yay it worked, unless this is buggy, then :(
-	return 1;
-}
-
-/** OS_IdThread
- *  @brief Get current thread ID
- *  @return id of thread
-*/
-INT32U OS_IdThread(void){
-	return RunPt->id;
-}
-
-/** OS_InitSemaphore
- *  @brief Initialize semaphore to given value
- *  @param  semaPt semaphore ptr
-*/
-void OS_InitSemaphore(Sema4Type *semaPt, INT32 value){	//Occurs once at the start
-	INT32U sr = StartCritical();
-	semaPt->Value = value;
-	semaPt->blockThreads = 0;
-	EndCritical(sr);
-}
-
-/** OS_Wait
- *  @brief semaphore value decrement
- *  @param  semaPt pointer to semaphore
- *  @return none
-*/
-void OS_Wait(Sema4Type *semaPt){ // Called at run time to provide synchronization between threads
-	
-	INT32U sr = StartCritical();
-	semaPt->Value--;
-	if (semaPt->Value < 0){
-		BlockTCB(semaPt);
-		}
-	EndCritical(sr);
-	
-}
-
-/** OS_Signal
- * @brief This function(Spinlock) will signal that a mutual exclusion is taking place in a function
- * @param semaPt 
-*/
-void OS_Signal(Sema4Type *semaPt){
-	INT32U sr = StartCritical();
-	semaPt->Value++;
-	
-	if(semaPt->Value < 1){
-		UnBlockTCB(semaPt);
-	}
-	EndCritical(sr);
-}
-
-/** OS_bWait
-* @brief This function implements binary wait
-* @param semaPt semaphore passed in
-
-* 
-*/
-void OS_bWait(Sema4Type *semaPt){
-	DisableInterrupts();
-	semaPt->Value--;
-	if (semaPt->Value < 0){
-		BlockTCB(semaPt);
-	}
-	EnableInterrupts();
-
-}
-
-/** OS_bSignal
-* @brief This function implements binary signal
-* @param semaPt semaphore passed in
-* 
-*/
-void OS_bSignal(Sema4Type *semaPt){
-	INT32U sr = StartCritical();
-	semaPt->Value++;
-	if(semaPt->Value < 1){
-		UnBlockTCB(semaPt);
-	}
-	EndCritical(sr);
-}
-
-/** OS_Sleep
-* @brief This function puts a thread to sleep
-* @param sleepTime time to put thread to sleep
-* 
-*/
-void OS_Sleep(INT32U sleepTime){
-	OS_DisableInterrupts();
-	// add current thread to sleep list like in class
-	RunPt->sleepState = sleepTime;
-	// Priroity Scheduling
-	PriorityAvailable[RunPt->priority]--;
-	
-	OS_Suspend();
-	OS_EnableInterrupts();
-}
-
-/** OS_Kill
-* @brief This function kill/deletes current thread from schedule
-*/
-void OS_Kill(void){
-	DisableInterrupts();
-	// Fix Priority Scheduler and remove TCB from all LL
-	tcbType *tmpPtr, *curPtr;
-	
-	// Killed Thread is head (top) of linked list, EZ, O(1), copy past LL
-	if ((RunPt == PriorityLastPtr[RunPt->priority]) && (RunPt == PriorityPtr[RunPt->priority])){ 
-		PriorityPtr[RunPt->priority] 		= 0;
-		PriorityLastPtr[RunPt->priority] 	= 0;
-	// Remove first link in list (O(1), copy pasta LL
-	} else if (RunPt == PriorityPtr[RunPt->priority]){	
-			PriorityLastPtr[RunPt->priority]->nextPriority = RunPt->nextPriority;
-			PriorityPtr[RunPt->priority] = PriorityLastPtr[RunPt->priority]->nextPriority;
-	// find thread to delete O(N)
-	} else {	
-		tmpPtr = PriorityPtr[RunPt->priority];
-		curPtr = PriorityPtr[RunPt->priority];
-		// dp searjc
-		while (curPtr != RunPt){
-			tmpPtr = curPtr; 
-			curPtr = curPtr->nextPriority; 
-		}
-		// check to see if last link in list
-		if (RunPt == PriorityLastPtr[RunPt->priority]){ 
-			tmpPtr->nextPriority = PriorityPtr[RunPt->priority];
-			PriorityLastPtr[RunPt->priority] = tmpPtr;
-		} else {	
-			tmpPtr->nextPriority = curPtr->nextPriority;
-		}
-	} 
-	// OS_Kill(Sikender); why doesnt this work?????
-	tcbs[RunPt->id].status = -1;
-	NumOfThreads--;
-	PriorityTotal[RunPt->priority]--;
-	PriorityAvailable[RunPt->priority]--;
-	
-	OS_Suspend(); 
-	EnableInterrupts();
-	//should never run
-	INT8U errorVar = 0;
-	while(1) errorVar++;
-}
-
-/** OS_AddPeriodicThread
- * @brief Adds periodic background thread. Cannot spin, sleep, die, rest, etc. cause it's ISR, depends on hardware for number of tasks possible
-			No ID for this thread, must have mid-high priority to run properly
- * @param task task to run in background
- * @param  period 
- * @param  priority 5-0 only, else you'll break OS :(
- * @return successful - 1, Fail - 0
-*/
-INT8 OS_AddPeriodicThread(void(*task)(void), INT32U period, INT32U priority){ 
-	static INT8U NumberOfPeriodicTasks = 0;
-	
-	if (NumberOfPeriodicTasks == 0){
-		Timer1A_Init(task, period, priority);
-	} else if (NumberOfPeriodicTasks == 1){
-		Timer1B_Init(task, period, priority);
-	} else if (NumberOfPeriodicTasks == 2){
-		Timer2A_Init(task, period, priority);
-	} else if (NumberOfPeriodicTasks == 3){
-		Timer2B_Init(task, period, priority);
-	} else if (NumberOfPeriodicTasks == 4){
-		Timer3A_Init(task, period, priority);
-	} else if (NumberOfPeriodicTasks == 5){
-		Timer3B_Init(task, period, priority);
-	} else if (NumberOfPeriodicTasks == 6){
-		Timer4A_Init(task, period, priority);
-	} else if (NumberOfPeriodicTasks == 7){
-		Timer4B_Init(task, period, priority);		
-	// no more timers dawg :(
-	}else{
-		return 0;
-	}
-	NumberOfPeriodicTasks++;
-	return 1;
-}
-
-/** OS_AddSW1Task
-* @brief This function adds a thread to run and its priority when a button is pressed
-* @param task function/thread to run when button pressed
-* @param priority
-* @return success or fail 
-*/
-INT8 OS_AddSW1Task(void(*task)(void), INT32U priority){
-	SW1_Init(task, priority);
-	return 1;	
-}
-
-/** OS_AddSW2Task
-* @brief This function adds a thread to run and its priority when a button is pressed
-* @param task function/thread to run when button pressed
-* @param priority
-* @return success or fail 
-*/
-
-INT8 OS_AddSW2Task(void(*task)(void), INT32U priority){
-	SW2_Init(task, priority);
-	return 1;	
-}
-
-/** OS_Fifo_Init
-* Initializes Fifo to be empty, ignored for lab 2, divisible by 2
-*/
-void OS_Fifo_Init(void){
-	INT32U sr = StartCritical();	// is this necessary? cause idk
-	Put_Idx = Get_Idx = 0;
-	OS_InitSemaphore(&SemaFIFO, 0);
-	EndCritical(sr);
-}
-
-/** OS_Fifo_Put
-* Adds data to FiFo
-* @param data
-* @return success - 1, Fail - 0
-* 
-*/
-INT8 OS_Fifo_Put(FIFO_t data){
-	// check if FiFo Full
-	if(SemaFIFO.Value == FIFO_SIZE) return 0;
-	
-	// add data to FiFo
-	OS_FIFO[Put_Idx] = data;
-	Put_Idx = (Put_Idx + 1) % FIFO_SIZE;
-	
-	// signal to show there's data
-	OS_Signal(&SemaFIFO);
-	return 1;
-} 
-
-/** OS_Fifo_Get
-* Retrieves data from OS Fifo
-* @return 1 for success, 0 for fail
-*/
-FIFO_t OS_Fifo_Get(void){
-	OS_Wait(&SemaFIFO);
-	FIFO_t data;
-	// check if empty
-	if(Put_Idx == Get_Idx) return 0;
-	// get and return data
-	data = OS_FIFO[Get_Idx];
-	Get_Idx = (Get_Idx + 1) % FIFO_SIZE;
-	return data;
-}
-
-/** OS_Fifo_Size
-* @brief Gets current size of FiFo
-* @return size of current FIFO buffer
-*/
-INT32U OS_Fifo_Size(void){
-	//return FiFo_Size_Unused; 
-	//return FIFO_SIZE;
-	INT32U size = SemaFIFO.Value;
-	return size;
-}
-
-/** OS_MailBox_Init
-* @brief Initializes communication channel for OS
-*/
-void OS_MailBox_Init(void){
-	//MailBox.data = -1;
-	// set semaphores
-	OS_InitSemaphore(&MailBox.Empty, 1); //FML i set this wrong 4AM
-	OS_InitSemaphore(&MailBox.Full,  0);
-}
-
-/** OS_MailBox_Send
-* Enter mail into the Mailbox
-* @brief This function will be called from a foreground thread
-* It will spin/block if the MailBox contains data not yet received 
-* @param data data to put into mailbox
-* 
-*/
-void OS_MailBox_Send(INT32U data){
-	// wait then signal to send data, wait until FiFo has space available
-	OS_bWait(&MailBox.Empty);
-	MailBox.data = data;
-	OS_bSignal(&MailBox.Full);
-}
-
-/** OS_MailBox_Recv
-* Remove mail from the mailbox
-* @brief This function will be called from a foreground thread
-* It will spin/block if the MailBox is empty
-* @return data from Mailbox
-* 
-*/
-INT32U OS_MailBox_Recv(void){
-	INT32U data;
-	OS_bWait(&MailBox.Full);
-	data = MailBox.data;
-	OS_bSignal(&MailBox.Empty);
-	return data;
-}
- 
-/** OS_Time
- *  @return OS time in 1/BUS_CLK increments
-*/
-INT32U OS_Time(void){
-	return TIMER0_TAR_R;
-}
-
-/**OS_TimeDifference
- * @param start
- * @param stop
- * @return time difference 
-*/
-INT32U OS_TimeDifference(INT32U start, INT32U stop){
-	if(start> stop)
-		return (start - stop);
-	else{
-		return (0xFFFFFFFF - stop + start);
-	}
-}
-
-/** OS_ClearMsTime
- *  Clear ms time
-*/
-void OS_ClearMsTime(void){
-	OS_SystemTimeMS  = 0;
-}
-
-/**OS_MsTime
- *  @return time in ms
-*/
-INT32U OS_ReadMsTime(void){
-	return OS_SystemTimeMS;
-}
-
+/**
+* @file OS.c
+* @brief Contains functions to run OS
+* 
+*/
+#include <stddef.h>
+#include "cpu.h"
+#include "startup.h"
+#include "Timer.h"
+#include "Switch.h"
+#include "UART0.h"
+#include "OS.h"
+
+
+// DWT cycle counter, counts bus clocks
+#define DEMCR_R			(*((volatile INT32U *)0xE000EDFC))
+#define DEMCR_TRCENA	0x01000000
+#define DWT_CTRL_R		(*((volatile INT32U *)0xE0001000))
+#define DWT_CTRL_CYCCNTENA	0x00000001
+#define DWT_CYCCNT_R	(*((volatile INT32U *)0xE0001004))
+
+// OS ASM functions
+void StartOS(void);
+void OS_EnableInterrupts(void);
+void OS_DisableInterrupts(void);
+
+
+/*! @var INT32U Stacks
+    @brief Contains all the stacks for each thread
+*/
+static INT32U Stacks[NUMTHREADS][STACKSIZE];
+
+/*! @var INT8U numOfThreads
+    @brief number of threads running
+*/
+static INT32U NumOfThreads = 0;
+
+/*! @var INT32U BusClock
+    @brief current bus clock in Hz, changed by OS_SetBusClock
+*/
+static INT32U BusClock = BUS_CLK;
+
+/*! @var INT32U OS_BasePri
+    @brief BASEPRI value of kernel critical sections, read by StartCritical and PendSV
+		priority in top 3 bits of byte
+*/
+const INT32U OS_BasePri = OS_MAX_SYSCALL_PRIORITY << 5;
+
+/*! @var INT32U SwitchTime
+    @brief OS_Time at last context switch, start of RunPt time slice
+*/
+static INT32U SwitchTime;
+
+/*! @var INT64U TimeBase
+    @brief OS time (1/BUS_CLK units) when cycle counter read CycBase
+*/
+static volatile INT64U TimeBase;
+
+/*! @var INT32U CycBase
+    @brief cycle counter at TimeBase, cycles since then are still at current bus clock
+*/
+static volatile INT32U CycBase;
+
+/*! @var INT32U TimeMul
+    @brief OS time units per bus cycle is TimeMul/TimeDiv (BUS_CLK/BusClock)
+*/
+static volatile INT32U TimeMul = 1;
+static volatile INT32U TimeDiv = 1;
+
+/*! @var INT32U TimeSeq
+    @brief bumped after TimeBase/CycBase change so OS_Time can read them without locking
+*/
+static volatile INT32U TimeSeq;
+
+/*! @var uint32_T OS_SystemTimeMS
+    @brief time OS has been running in ms
+*/
+static INT64U OS_SystemTimeMS;
+
+/*! @var MailBoxType MailBox
+	@brief mailbox variable defined for OS mailbox
+*/
+static MailBoxType MailBox;
+
+
+/** @var Thread Control Block
+ * @brief Structure for each thread, helps with context switching, Now Doubly linked List
+*/
+struct Tcb{
+	/*@{*/
+	INT32U *sp;			/**< pointer to stack (valid for threads not running */
+	// double LL
+	struct Tcb* next;		/**< Pointer to next TCB */
+	struct Tcb* prev;
+	// basic properties
+	INT32 id;					/**< ID number of thread, negative if unused */
+	INT32 status;				/**< status of thread: -1: unused, 1: used */
+	INT8U priority;		/**< priority of thread, 0-5 */
+	INT32U sleepState;		/**< set while sleeping */
+	TimerType wakeTimer;	/**< wheel entry for sleep and timed wait */
+	// Lab 3 blocking threads
+	Sema4Type* sema4Blocked;	/**< blocked state */
+	struct Tcb* nextBlocked;
+	INT8U timedOut;			/**< set if OS_WaitTimeout gave up */
+	// scratch arena, only touched by owning thread
+	INT8U* arena;			/**< arena block from pool, 0 if none */
+	INT32U arenaSize;		/**< bytes in arena */
+	INT32U arenaUsed;		/**< bump pointer offset */
+	PoolType* arenaPool;	/**< pool arena came from */
+	// cpu accounting, updated by PendSV
+	INT64U runCycles;		/**< bus cycles spent running */
+	INT32U switchesIn;		/**< times switched to */
+	INT32U preemptions;		/**< switched out while still ready */
+	INT32U yields;			/**< switched out by own OS_Suspend (block, sleep, yield) */
+	INT8U yielding;			/**< set by OS_Suspend until next switch */
+	// wake-to-run latency, OS_CSPROFILE
+	INT32U readyTime;		/**< OS_Time when made ready */
+	INT8U wakePending;		/**< woken, not yet switched to */
+	INT32U wakeCount;		/**< wakes timed */
+	INT32U wakeMax;			/**< worst cycles from ready to running */
+	INT64U wakeTotal;		/**< sum of wake-to-run cycles */
+	struct Tcb* nextPriority;
+	/*@}*/
+};
+typedef struct Tcb tcbType;
+static tcbType tcbs[NUMTHREADS];
+
+static void TimeoutTCB(tcbType* thread);
+static void ThreadWake(TimerType *timer);
+static void MarkReady(tcbType* thread);
+
+/*! @var tcbType *RunPt
+    @brief Contains currently running thread 
+*/
+tcbType *RunPt;
+
+/*! @var tcbType *NextRunPt
+    @brief Contains next thread to run
+*/
+tcbType *NextRunPt;
+
+/*! @var FIFO_t OS_FIFO
+    @brief Contains next thread to run
+*/
+static FIFO_t OS_FIFO[FIFO_SIZE];
+static QueueType FifoQueue;
+
+//************* PRIORITY SCHEDULING GLOBALS AND ARRAYS**************************************************************************
+//Value > 0, else 0 if empty, change upon OS_Kill, Total number of threads in priority level
+INT32 PriorityTotal[PRIORITYLEVELS] 		= {0};		
+// Array to skip threads if threas sleep/block, if 0 move to next thread, Avaliable priorities to run
+INT32 PriorityAvailable[PRIORITYLEVELS] 	= {0};
+// LL for each priority level 
+tcbType* PriorityPtr[PRIORITYLEVELS] 		= {0};	
+// Pointer to end of LL
+tcbType* PriorityLastPtr[PRIORITYLEVELS] 	= {0};
+
+//*********************************************** Basic OS Initilization Functions ********************
+//*********************************************** Add CPU/Peripheral Functions to these if desired ********************
+
+/** SetInitialStack
+ *	@brief sets stack to default values
+ * @param i tcb thread number
+ * 
+*/
+static void SetInitialStack(INT32U i){
+  tcbs[i].sp = &Stacks[i][STACKSIZE-16]; // thread stack pointer
+  Stacks[i][STACKSIZE-1] = 0x01000000;   // thumb bit
+  Stacks[i][STACKSIZE-3] = 0x14141414;   // R14
+  Stacks[i][STACKSIZE-4] = 0x12121212;   // R12
+  Stacks[i][STACKSIZE-5] = 0x03030303;   // R3
+  Stacks[i][STACKSIZE-6] = 0x02020202;   // R2
+  Stacks[i][STACKSIZE-7] = 0x01010101;   // R1
+  Stacks[i][STACKSIZE-8] = 0x00000000;   // R0
+  Stacks[i][STACKSIZE-9] = 0x11111111;   // R11
+  Stacks[i][STACKSIZE-10] = 0x10101010;  // R10
+  Stacks[i][STACKSIZE-11] = 0x09090909;  // R9
+  Stacks[i][STACKSIZE-12] = 0x08080808;  // R8
+  Stacks[i][STACKSIZE-13] = 0x07070707;  // R7
+  Stacks[i][STACKSIZE-14] = 0x06060606;  // R6
+  Stacks[i][STACKSIZE-15] = 0x05050505;  // R5
+  Stacks[i][STACKSIZE-16] = 0x04040404;  // R4
+}
+
+/** SetThreads
+* @brief Set Threads to default values for unused.
+* 
+*/
+static void SetThreads(void){
+	for (INT8 i = 0; i < NUMTHREADS; i++){
+		tcbs[i].status = -1;
+		tcbs[i].id = -1;
+		tcbs[i].sleepState = 0;
+		tcbs[i].wakeTimer.expireFn = &ThreadWake;
+		tcbs[i].wakeTimer.active = 0;
+	}
+	for (INT8 i = 0; i < PRIORITYLEVELS; i++){
+		PriorityPtr[i] = 0;
+	}
+}
+	
+/** OS_SleepHandler
+ * @brief 1 ms tick, advances timing wheel which wakes sleeping threads, times out waits and runs software timers
+ *  @return none
+*/
+static void OS_SleepHandler(void){
+	// increment timer for sleep
+	OS_TRACE_ISR_ENTER();
+	OS_SystemTimeMS++;
+	// fold cycles into time base so no wrap of cycle counter is missed (wraps every 53 s)
+	OS_Time64();
+	OS_WheelTick();
+	OS_TRACE_ISR_EXIT();
+}
+
+/** ThreadWake
+ * @brief Wheel expire hook for thread wakeTimer, ends sleep or timed wait
+ * @param timer wakeTimer of thread
+*/
+static void ThreadWake(TimerType *timer){
+	tcbType *thread = (tcbType*)((INT8U*)timer - offsetof(tcbType, wakeTimer));
+	INT32U sr = StartCritical();
+	// timed wait ran out, pull it off the semaphore
+	if(thread->sema4Blocked){
+		TimeoutTCB(thread);
+	}else if(thread->sleepState){
+		thread->sleepState = 0;
+		PriorityAvailable[thread->priority]++;
+		MarkReady(thread);
+	}
+	EndCritical(sr);
+}
+
+/** OS_ClockInit
+ * @brief Start DWT cycle counter that OS_Time64 extends to 64 bits
+*/
+static void OS_ClockInit(void){
+	DEMCR_R |= DEMCR_TRCENA;
+	DWT_CYCCNT_R = 0;
+	DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;
+	TimeBase = 0;
+	CycBase = 0;
+	TimeMul = TimeDiv = 1;
+	TimeSeq++;
+}
+
+/** CyclesToTime
+ * @brief Convert bus cycles to OS time units, split so it never overflows
+ * @param cycles bus cycles
+ * @param mul TimeMul
+ * @param div TimeDiv
+ * @return OS time units, low 32 bits
+*/
+static INT32U CyclesToTime(INT32U cycles, INT32U mul, INT32U div){
+	INT32U q = cycles/div;
+	return q*mul + (cycles - q*div)*mul/div;
+}
+
+/** TimeFold
+ * @brief Move whole multiples of TimeDiv cycles into TimeBase, remainder stays so
+ *	nothing is lost to rounding, interrupts off
+*/
+static void TimeFold(void){
+	INT32U q = (DWT_CYCCNT_R - CycBase)/TimeDiv;
+	TimeBase += (INT64U)q*TimeMul;
+	CycBase += q*TimeDiv;
+	TimeSeq++;
+}
+
+/** Peripheral_Init
+* @brief This function initializes extra IO used by OS, add new inits here
+*/
+void Peripheral_Init(void){
+	// 1 ms timer for OS/ sleep decrement
+	Timer0A_Init(&OS_SleepHandler, TIME_1MS, OS_MAX_SYSCALL_PRIORITY);
+	// bus clock resolution time
+	OS_ClockInit();
+
+}
+
+/** OS_SystemtPriority
+ *	@brief Set priority of Systick and PendSV (Context Switch handlers)
+*/
+void OS_SystemPriority(void){
+	NVIC_SYS_PRI3_R =(NVIC_SYS_PRI3_R&0x00FFFFFF)|0xD0000000; // priority 6
+	NVIC_SYS_PRI3_R =(NVIC_SYS_PRI3_R&0xFF00FFFF)|0x00E00000; // priority 7
+
+}
+
+/** OS_Init
+ *	@brief initialize operating system, disable interrupts until OS_Launch
+ *	initialize OS controlled I/O: serial, ADC, systick, LaunchPad I/O and timers 
+*/
+void OS_Init(void){
+	OS_DisableInterrupts();
+	Peripheral_Init();
+	OS_SystemTimeMS = 0;
+	SetThreads();
+	OS_SystemPriority();
+	OS_HeapInit();
+	OS_TimerServiceInit();
+#if OS_TRACE
+	OS_TraceInit();
+#endif
+	RunPt = &tcbs[0]; 
+	OS_DeferInit();
+	OS_WorkPoolInit();
+}
+
+/** @brief  LinkTCB
+ *	Add TCB to doubly Linked List, copy pasta ee 312
+*/
+void LinkTCB(tcbType* newThread){
+	// add to Doubly LL, copy pasta
+	tcbType* endPtr = RunPt->prev;
+	// increment count
+	PriorityAvailable[newThread->priority]++;
+	newThread->next = RunPt;
+	RunPt->prev = newThread;
+	newThread->prev = endPtr;
+	endPtr->next = newThread;
+	
+	//increment thread count
+	NumOfThreads++;
+}
+
+/** @brief  UnLinkTCB
+ *	Remove thread form Doubly LL of TCB, copy pasta 
+*/
+void UnLinkTCB(void){
+	//do removal for double LL
+	RunPt->prev->next = RunPt->next;
+	RunPt->next->prev = RunPt->prev;
+	NumOfThreads--;
+}
+
+/** AddBlockedToSema4
+ *	@brief Add TCB to blocked Linked list of semaphore
+ *  @param semaPt ptr to semaphore
+*/
+void AddBlockedToSemaphore(Sema4Type* semaPt){
+	// go to end of LL to add tcb or add to head, copy pasta
+	if(semaPt->blockThreads == 0){
+		semaPt->blockThreads = RunPt;
+		semaPt->blockThreads->nextBlocked = 0;
+	}else{
+		// go to end
+		tcbType* endPtr = semaPt->blockThreads;
+		while(endPtr->nextBlocked != 0){
+			endPtr = endPtr->nextBlocked;
+		}
+		endPtr->nextBlocked = RunPt;
+		endPtr->nextBlocked->nextBlocked = 0;
+	}
+}
+
+/** RemoveBlockedFromSemaphore
+ *	@brief Remove TCB from blocked list, assuiming thread already blocked, else rip program
+ *  @param semaPt ptr to semaphore
+ *  @return tcb that is no longer blocked from list
+*/
+tcbType* RemoveBlockedFromSemaphore(Sema4Type* semaPt){
+	// copy pasta ee 312, 
+	tcbType* headLink = semaPt->blockThreads;
+	semaPt->blockThreads = headLink->nextBlocked;
+	return headLink;
+}
+
+/** UnBlockTCB
+ *	@brief Remove TCB from blocked list
+ *  @param semaPt ptr to semaphore
+*/
+void UnBlockTCB(Sema4Type* semaPt){
+	tcbType* blocked = RemoveBlockedFromSemaphore(semaPt);
+	OS_TRACE_EVENT(TRACE_UNBLOCK, blocked->id, (INT32U)semaPt);
+	LinkTCB(blocked);
+	blocked->sema4Blocked = 0;
+	MarkReady(blocked);
+	OS_WheelRemove(&blocked->wakeTimer);	// cancel timeout if timed wait
+}
+
+/** TimeoutTCB
+ *	@brief Remove TCB from middle of blocked list when its timed wait expires, called from wheel
+ *  @param thread tcb whose timeout ran out
+*/
+static void TimeoutTCB(tcbType* thread){
+	Sema4Type* semaPt = thread->sema4Blocked;
+	tcbType** link = &semaPt->blockThreads;
+	OS_TRACE_EVENT(TRACE_TIMEOUT, thread->id, (INT32U)semaPt);
+	// find link pointing at thread
+	while(*link != thread){
+		link = &(*link)->nextBlocked;
+	}
+	*link = thread->nextBlocked;
+	// give back the count OS_WaitTimeout took
+	semaPt->Value++;
+	thread->timedOut = 1;
+	thread->sema4Blocked = 0;
+	LinkTCB(thread);
+	MarkReady(thread);
+}
+
+/** MarkReady
+ *	@brief Stamp thread made ready so OS_SwitchHook can time wake-to-run, interrupts off
+ *  @param thread tcb just woken
+*/
+static void MarkReady(tcbType* thread){
+#if OS_CSPROFILE
+	thread->readyTime = OS_Time();
+	thread->wakePending = 1;
+#endif
+}
+
+/** BlockTCB
+ *	@brief Add current TCB to blocked list then yield, ratatatat
+ *  @param semaPt ptr to semaphore
+*/
+void BlockTCB(Sema4Type* semaPt){
+	OS_TRACE_EVENT(TRACE_BLOCK, RunPt->id, (INT32U)semaPt);
+	RunPt->sema4Blocked = semaPt;
+	PriorityAvailable[RunPt->priority]--;
+	UnLinkTCB();
+	AddBlockedToSemaphore(semaPt);
+	OS_Suspend();
+}
+
+/** OS_Launch
+* @brief This function starts the scheduler and enables interrupts
+* @param theTimeSlice period of round robin scheduler
+
+* 
+*/
+void OS_Launch(INT32U theTimeSlice){
+	INT32 pri = 0;
+	for (pri = 0; pri < PRIORITYLEVELS; pri++){
+		if (PriorityAvailable[pri] > 0)
+			break;
+	}
+	
+	RunPt = PriorityPtr[pri];
+	RunPt->switchesIn++;
+	SwitchTime = OS_Time();
+	SysTick_Init(theTimeSlice);
+	StartOS();
+}
+
+/** OS_Scheduler
+* @brief This function runs next highest priority thread, PRIORITY SCHEDULER
+*/
+void OS_Scheduler(void){
+	INT32 pri = 0;
+	NextRunPt = RunPt->next;
+	// go through priority list, exit when next highest thread found
+	for (pri = 0; pri < PRIORITYLEVELS; pri++){
+		if (PriorityAvailable[pri] > 0)
+			break;
+	}
+
+	// check if next priority thread is the same priority
+	if (pri == RunPt->priority){	
+		NextRunPt = RunPt->nextPriority;
+		// Ensure next thread not sleeping 
+		while(NextRunPt->sleepState || NextRunPt->sema4Blocked){
+			NextRunPt = NextRunPt->nextPriority;
+		} 
+	// run lower pri task
+	}else{
+		if (pri != PRIORITYLEVELS){
+			NextRunPt = PriorityPtr[pri];
+			// Ensure next thread not sleeping 
+			while(NextRunPt->sleepState || NextRunPt->sema4Blocked){	
+				NextRunPt = NextRunPt->nextPriority;
+			}
+		}
+	}
+	
+}
+
+/** SysTick_Handler
+ * @brief This function decides next thread to run
+**/
+void SysTick_Handler(void){
+	OS_Scheduler();
+	//go to pendSV
+	NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV; // go to context switch
+	//PE1 ^= 0x02;
+}
+
+/** OS_Suspend
+* @brief This function suspends current thread by forcing context switch call
+* 
+*/
+void OS_Suspend(void)
+{
+	//OS_Scheduler();
+	//NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV; // go to context switch
+	NVIC_ST_CURRENT_R = 0;      // clear timer
+	RunPt->yielding = 1;		// switch is voluntary, not preemption
+	NVIC_INT_CTRL_R = 0x04000000; // go to SysTick Handler
+}
+
+/** OS_SwitchHook
+* @brief Called by PendSV before RunPt changes, charges elapsed cycles to old thread
+*	and counts switch as preemption or yield, interrupts are off
+*/
+void OS_SwitchHook(void){
+	INT32U now = OS_Time();
+	INT8U yielding;
+	RunPt->runCycles += now - SwitchTime;
+	SwitchTime = now;
+#if OS_CSPROFILE
+	if(NextRunPt->wakePending){
+		INT32U latency = now - NextRunPt->readyTime;
+		NextRunPt->wakePending = 0;
+		NextRunPt->wakeCount++;
+		NextRunPt->wakeTotal += latency;
+		if(latency > NextRunPt->wakeMax){
+			NextRunPt->wakeMax = latency;
+		}
+	}
+#endif
+	yielding = RunPt->yielding;
+	RunPt->yielding = 0;	// clear even if picked again so next preemption is not a yield
+	if(NextRunPt == RunPt){
+		return;
+	}
+	if(yielding){
+		RunPt->yields++;
+	}else{
+		RunPt->preemptions++;
+	}
+	NextRunPt->switchesIn++;
+	OS_TRACE_EVENT(TRACE_SWITCH, NextRunPt->id, RunPt->id);
+}
+
+/** OS_GetThreadStats
+* @brief Copy cpu accounting of thread
+* @param id thread id (0 to NUMTHREADS-1)
+* @param stats output
+* @return 1 if thread alive, 0 if not
+*/
+INT8 OS_GetThreadStats(INT32U id, ThreadStatsType *stats){
+	INT32U sr;
+	tcbType *thread;
+	if(id >= NUMTHREADS || tcbs[id].status == -1){
+		return 0;
+	}
+	thread = &tcbs[id];
+	sr = StartCritical();
+	stats->id = thread->id;
+	stats->priority = thread->priority;
+	stats->runCycles = thread->runCycles;
+	// running thread, add its current slice
+	if(thread == RunPt){
+		stats->runCycles += OS_Time() - SwitchTime;
+	}
+	stats->switchesIn = thread->switchesIn;
+	stats->preemptions = thread->preemptions;
+	stats->yields = thread->yields;
+	stats->wakeCount = thread->wakeCount;
+	stats->wakeMax = thread->wakeMax;
+	stats->wakeTotal = thread->wakeTotal;
+	EndCritical(sr);
+	return 1;
+}
+
+/** OS_WakeClear
+* @brief Reset wake-to-run stats of all threads, for OS_CSClear
+*/
+void OS_WakeClear(void){
+	INT32U i;
+	INT32U sr = StartCritical();
+	for(i = 0; i < NUMTHREADS; i++){
+		tcbs[i].wakePending = 0;
+		tcbs[i].wakeCount = 0;
+		tcbs[i].wakeMax = 0;
+		tcbs[i].wakeTotal = 0;
+	}
+	EndCritical(sr);
+}
+
+/** OS_AddThread
+* @brief This function decides next thread to run, now uses priority scheduler
+* @param newThread
+
+* 
+*/
+void OS_AddPriorityThread(tcbType* newThread){
+	INT32 pri = newThread->priority;
+	
+	// Add head priority task
+	if(PriorityTotal[pri] == 0){
+		PriorityPtr[pri] 		= newThread;
+		PriorityLastPtr[pri] 	= newThread;
+		newThread->nextPriority = newThread;
+	// Add thread to existing LL, put at head so O(1)
+	} else{
+		newThread->nextPriority 			= PriorityLastPtr[pri]->nextPriority;
+		PriorityLastPtr[pri]->nextPriority 	= newThread;
+		PriorityPtr[pri] 					= newThread;
+	}
+	
+	//increment counters
+	PriorityAvailable[pri]++;
+	PriorityTotal[pri]++;
+	
+}
+
+/** OS_AddThread
+* @brief This function decides next thread to run, now uses priority scheduler
+* @param task
+* @param stackSize
+* @param priority
+* @return 1-success, 0-fail
+* 
+*/
+INT8 OS_AddThread(void(*task)(void), INT32U priority){
+	// check if max thread limit reached
+	if(NumOfThreads >= NUMTHREADS){
+		return 0; 
+	}
+	// Start of adding thread
+	INT32U sr = StartCritical();
+	
+	// search for availalbe tcb
+	INT8 idxFreeTCB = 0;
+	for(idxFreeTCB = 0; idxFreeTCB < NUMTHREADS; idxFreeTCB++){
+		//break once found
+		if(tcbs[idxFreeTCB].status == -1){
+			break;
+		}
+	}
+	
+	// check if this is the only thread
+	if(NumOfThreads == 0){
+		tcbs[NumOfThreads].next = &tcbs[0];
+		tcbs[NumOfThreads].prev = &tcbs[0];
+		RunPt = &tcbs[0];
+		tcbs[0].priority = priority;
+	}
+	// add thread, treat like linked list, (code from EE312)
+	else{ 
+		if(RunPt->status == -1 || idxFreeTCB >= NUMTHREADS){
+			EndCritical(sr);
+			return 0;
+		}
+		
+		//insertion for doubly linked list
+		tcbType* endPtr = RunPt->prev; 
+		tcbs[idxFreeTCB].next = RunPt;		
+		RunPt->prev = &tcbs[idxFreeTCB];
+		tcbs[idxFreeTCB].prev = endPtr;
+		endPtr->next = &tcbs[idxFreeTCB];
+	}
+	//init stack and add task to TCB
+	SetInitialStack(idxFreeTCB);
+	Stacks[idxFreeTCB][STACKSIZE-2] = (INT32)(task); // PC
+	
+	// init vars of tcb
+	tcbs[idxFreeTCB].sleepState = 0;
+	tcbs[idxFreeTCB].status = 0; 
+	tcbs[idxFreeTCB].id = idxFreeTCB;
+	tcbs[idxFreeTCB].priority = priority;
+	tcbs[idxFreeTCB].arena = 0;
+	tcbs[idxFreeTCB].runCycles = 0;
+	tcbs[idxFreeTCB].switchesIn = 0;
+	tcbs[idxFreeTCB].preemptions = 0;
+	tcbs[idxFreeTCB].yields = 0;
+	tcbs[idxFreeTCB].yielding = 0;
+	tcbs[idxFreeTCB].wakePending = 0;
+	tcbs[idxFreeTCB].wakeCount = 0;
+	tcbs[idxFreeTCB].wakeMax = 0;
+	tcbs[idxFreeTCB].wakeTotal = 0;
+	
+	//increment thread count
+	NumOfThreads++;
+	
+	// Go to Priority Scheduler addition
+	OS_AddPriorityThread(&tcbs[idxFreeTCB]);
+	EndCritical(sr);
+	// yay it worked, unless this is buggy, then :(
+	return 1;
+}
+
+/** OS_IdThread
+ *  @brief Get current thread ID
+ *  @return id of thread
+*/
+INT32U OS_IdThread(void){
+	return RunPt->id;
+}
+
+/** OS_InitSemaphore
+ *  @brief Initialize semaphore to given value
+ *  @param  semaPt semaphore ptr
+*/
+void OS_InitSemaphore(Sema4Type *semaPt, INT32 value){	//Occurs once at the start
+	INT32U sr = StartCritical();
+	semaPt->Value = value;
+	semaPt->blockThreads = 0;
+	EndCritical(sr);
+}
+
+/** OS_Wait
+ *  @brief semaphore value decrement
+ *  @param  semaPt pointer to semaphore
+ *  @return none
+*/
+void OS_Wait(Sema4Type *semaPt){ // Called at run time to provide synchronization between threads
+	
+	INT32U sr = StartCritical();
+	semaPt->Value--;
+	if (semaPt->Value < 0){
+		BlockTCB(semaPt);
+		}
+	EndCritical(sr);
+	
+}
+
+/** OS_Signal
+ * @brief This function(Spinlock) will signal that a mutual exclusion is taking place in a function
+ * @param semaPt 
+*/
+void OS_Signal(Sema4Type *semaPt){
+	INT32U sr = StartCritical();
+	semaPt->Value++;
+	
+	if(semaPt->Value < 1){
+		UnBlockTCB(semaPt);
+	}
+	EndCritical(sr);
+}
+
+/** OS_WaitTimeout
+ *  @brief semaphore decrement, gives up after timeout ms
+ *  @param  semaPt pointer to semaphore
+ *  @param  timeout max time to block (ms), 0 does not block, OS_WAIT_FOREVER never times out
+ *  @return 1 if semaphore taken, 0 if timed out
+*/
+INT8 OS_WaitTimeout(Sema4Type *semaPt, INT32U timeout){
+	INT32U sr = StartCritical();
+	if(semaPt->Value > 0){
+		semaPt->Value--;
+		EndCritical(sr);
+		return 1;
+	}
+	if(timeout == 0){
+		EndCritical(sr);
+		return 0;
+	}
+	semaPt->Value--;
+	RunPt->timedOut = 0;
+	// wheel wakes us if nobody signals in time
+	if(timeout != OS_WAIT_FOREVER){
+		OS_WheelAdd(&RunPt->wakeTimer, timeout);
+	}
+	BlockTCB(semaPt);
+	EndCritical(sr);
+	// back from context switch, either signaled or timed out
+	return (RunPt->timedOut == 0);
+}
+
+/** OS_TryWait
+ *  @brief semaphore decrement only if free, never blocks so ISR safe
+ *  @param  semaPt pointer to semaphore
+ *  @return 1 if semaphore taken, 0 if busy
+*/
+INT8 OS_TryWait(Sema4Type *semaPt){
+	INT32U sr = StartCritical();
+	if(semaPt->Value > 0){
+		semaPt->Value--;
+		EndCritical(sr);
+		return 1;
+	}
+	EndCritical(sr);
+	return 0;
+}
+
+/** OS_TryWaitN
+ *  @brief take up to n free counts of semaphore, never blocks, used for batches
+ *  @param  semaPt pointer to semaphore
+ *  @param  n max counts to take
+ *  @return number of counts taken
+*/
+INT32U OS_TryWaitN(Sema4Type *semaPt, INT32U n){
+	INT32U taken = 0;
+	INT32U sr = StartCritical();
+	if(semaPt->Value > 0){
+		taken = ((INT32U)semaPt->Value < n) ? (INT32U)semaPt->Value : n;
+		semaPt->Value -= taken;
+	}
+	EndCritical(sr);
+	return taken;
+}
+
+/** OS_SignalN
+ * @brief signal n counts at once, wakes up to n blocked threads
+ *		value moves once, only threads actually waiting are unblocked
+ * @param semaPt 
+ * @param n number of counts
+*/
+void OS_SignalN(Sema4Type *semaPt, INT32U n){
+	INT32U wake = 0;
+	INT32U sr = StartCritical();
+	// negative value is number of blocked threads
+	if(semaPt->Value < 0){
+		wake = ((INT32U)(-semaPt->Value) < n) ? (INT32U)(-semaPt->Value) : n;
+	}
+	semaPt->Value += n;
+	while(wake > 0){
+		UnBlockTCB(semaPt);
+		wake--;
+	}
+	EndCritical(sr);
+}
+
+/** OS_bWait
+* @brief This function implements binary wait
+* @param semaPt semaphore passed in
+
+* 
+*/
+void OS_bWait(Sema4Type *semaPt){
+	DisableInterrupts();
+	semaPt->Value--;
+	if (semaPt->Value < 0){
+		BlockTCB(semaPt);
+	}
+	EnableInterrupts();
+
+}
+
+/** OS_bSignal
+* @brief This function implements binary signal
+* @param semaPt semaphore passed in
+* 
+*/
+void OS_bSignal(Sema4Type *semaPt){
+	INT32U sr = StartCritical();
+	semaPt->Value++;
+	if(semaPt->Value < 1){
+		UnBlockTCB(semaPt);
+	}
+	EndCritical(sr);
+}
+
+/** OS_Sleep
+* @brief This function puts a thread to sleep
+* @param sleepTime time to put thread to sleep
+* 
+*/
+void OS_Sleep(INT32U sleepTime){
+	OS_DisableInterrupts();
+	if(sleepTime){
+		// wheel wakes thread when time is up
+		RunPt->sleepState = 1;
+		OS_WheelAdd(&RunPt->wakeTimer, sleepTime);
+		// Priroity Scheduling
+		PriorityAvailable[RunPt->priority]--;
+	}
+	
+	OS_Suspend();
+	OS_EnableInterrupts();
+}
+
+/** OS_SleepUntil
+* @brief Sleep until lastWake + period, for fixed rate loops that should not drift
+* @param lastWake tick of last wake (set to OS_TickCount before loop), advanced by period
+* @param period ms between wakes
+* @return 1 slept, 0 overrun: deadline already passed so did not sleep
+*/
+INT8 OS_SleepUntil(INT32U *lastWake, INT32U period){
+	INT32U wake, now;
+	OS_DisableInterrupts();
+	wake = *lastWake + period;
+	*lastWake = wake;
+	now = OS_TickCount();
+	if((INT32)(wake - now) <= 0){
+		OS_EnableInterrupts();
+		return 0;
+	}
+	RunPt->sleepState = 1;
+	OS_WheelAdd(&RunPt->wakeTimer, wake - now);
+	PriorityAvailable[RunPt->priority]--;
+	
+	OS_Suspend();
+	OS_EnableInterrupts();
+	return 1;
+}
+
+/** OS_Kill
+* @brief This function kill/deletes current thread from schedule
+*/
+void OS_Kill(void){
+	DisableInterrupts();
+	// give scratch arena back so pool doesnt leak
+	OS_ArenaDetach();
+	// Fix Priority Scheduler and remove TCB from all LL
+	tcbType *tmpPtr, *curPtr;
+	
+	// Killed Thread is head (top) of linked list, EZ, O(1), copy past LL
+	if ((RunPt == PriorityLastPtr[RunPt->priority]) && (RunPt == PriorityPtr[RunPt->priority])){ 
+		PriorityPtr[RunPt->priority] 		= 0;
+		PriorityLastPtr[RunPt->priority] 	= 0;
+	// Remove first link in list (O(1), copy pasta LL
+	} else if (RunPt == PriorityPtr[RunPt->priority]){	
+			PriorityLastPtr[RunPt->priority]->nextPriority = RunPt->nextPriority;
+			PriorityPtr[RunPt->priority] = PriorityLastPtr[RunPt->priority]->nextPriority;
+	// find thread to delete O(N)
+	} else {	
+		tmpPtr = PriorityPtr[RunPt->priority];
+		curPtr = PriorityPtr[RunPt->priority];
+		// dp searjc
+		while (curPtr != RunPt){
+			tmpPtr = curPtr; 
+			curPtr = curPtr->nextPriority; 
+		}
+		// check to see if last link in list
+		if (RunPt == PriorityLastPtr[RunPt->priority]){ 
+			tmpPtr->nextPriority = PriorityPtr[RunPt->priority];
+			PriorityLastPtr[RunPt->priority] = tmpPtr;
+		} else {	
+			tmpPtr->nextPriority = curPtr->nextPriority;
+		}
+	} 
+	// OS_Kill(Sikender); why doesnt this work?????
+	tcbs[RunPt->id].status = -1;
+	NumOfThreads--;
+	PriorityTotal[RunPt->priority]--;
+	PriorityAvailable[RunPt->priority]--;
+	
+	OS_Suspend(); 
+	EnableInterrupts();
+	//should never run
+	INT8U errorVar = 0;
+	while(1) errorVar++;
+}
+
+/** OS_ArenaAttach
+* @brief Give current thread a scratch arena, one block of pool
+* @param pool pool to take block from, block size is arena size
+* @return 1 if attached, 0 if pool empty
+*/
+INT8 OS_ArenaAttach(PoolType *pool){
+	INT8U *block;
+	OS_ArenaDetach();
+	block = (INT8U*)OS_PoolAlloc(pool);
+	if(block == 0){
+		return 0;
+	}
+	RunPt->arenaPool = pool;
+	RunPt->arenaSize = pool->blockSize;
+	RunPt->arenaUsed = 0;
+	RunPt->arena = block;
+	return 1;
+}
+
+/** OS_ArenaAlloc
+* @brief Bump pointer alloc from current thread arena, no lock since only owner uses it
+* @param size bytes needed
+* @return 8 byte aligned memory, 0 if arena full or none attached
+*/
+void* OS_ArenaAlloc(INT32U size){
+	tcbType *thread = RunPt;
+	INT32U offset;
+	if(thread->arena == 0){
+		return 0;
+	}
+	// align address not offset, pool blocks are only 4 byte aligned
+	offset = (INT32U)((((uintptr_t)thread->arena + thread->arenaUsed + 7) & ~(uintptr_t)7) - (uintptr_t)thread->arena);
+	if(offset > thread->arenaSize || size > thread->arenaSize - offset){
+		return 0;
+	}
+	thread->arenaUsed = offset + size;
+	return &thread->arena[offset];
+}
+
+/** OS_ArenaReset
+* @brief Free everything allocated from current thread arena, O(1)
+*/
+void OS_ArenaReset(void){
+	RunPt->arenaUsed = 0;
+}
+
+/** OS_ArenaDetach
+* @brief Give current thread arena block back to its pool
+*/
+void OS_ArenaDetach(void){
+	if(RunPt->arena != 0){
+		OS_PoolFree(RunPt->arenaPool, RunPt->arena);
+		RunPt->arena = 0;
+	}
+}
+
+/** OS_AddSW1Task
+* @brief This function adds a thread to run and its priority when a button is pressed
+* @param task function/thread to run when button pressed
+* @param priority
+* @return success or fail 
+*/
+INT8 OS_AddSW1Task(void(*task)(void), INT32U priority){
+	// task calls OS, keep it maskable
+	if(priority < OS_MAX_SYSCALL_PRIORITY){
+		priority = OS_MAX_SYSCALL_PRIORITY;
+	}
+	SW1_Init(task, priority);
+	return 1;	
+}
+
+/** OS_AddSW2Task
+* @brief This function adds a thread to run and its priority when a button is pressed
+* @param task function/thread to run when button pressed
+* @param priority
+* @return success or fail 
+*/
+
+INT8 OS_AddSW2Task(void(*task)(void), INT32U priority){
+	if(priority < OS_MAX_SYSCALL_PRIORITY){
+		priority = OS_MAX_SYSCALL_PRIORITY;
+	}
+	SW2_Init(task, priority);
+	return 1;	
+}
+
+/** OS_Fifo_Init
+* Initializes Fifo to be empty, OS Fifo is a queue over OS_FIFO
+*/
+void OS_Fifo_Init(void){
+	OS_QueueInit(&FifoQueue, OS_FIFO, sizeof(FIFO_t), FIFO_SIZE);
+}
+
+/** OS_Fifo_Put
+* Adds data to FiFo, does not block so safe to call from ISR
+* @param data
+* @return success - 1, Fail - 0 (full, counted as dropped)
+* 
+*/
+INT8 OS_Fifo_Put(FIFO_t data){
+	OS_TRACE_FIFO(TRACE_FIFO_PUT, 1);
+	return OS_QueueTryPut(&FifoQueue, &data);
+} 
+
+/** OS_Fifo_PutTimeout
+* Adds data to FiFo, blocks while full until timeout, foreground threads only
+* @param data
+* @param timeout max time to block (ms)
+* @return success - 1, Fail - 0 (timed out, counted as dropped)
+*/
+INT8 OS_Fifo_PutTimeout(FIFO_t data, INT32U timeout){
+	OS_TRACE_FIFO(TRACE_FIFO_PUT, 1);
+	return OS_QueuePutTimeout(&FifoQueue, &data, timeout);
+}
+
+/** OS_Fifo_PutN
+* Adds block of data to FiFo, does not block so safe to call from ISR
+* @param data
+* @param n number of items
+* @return number of items put, rest counted as dropped
+*/
+INT32U OS_Fifo_PutN(const FIFO_t *data, INT32U n){
+	OS_TRACE_FIFO(TRACE_FIFO_PUT, n);
+	return OS_QueueTryPutN(&FifoQueue, data, n);
+}
+
+/** OS_Fifo_Get
+* Retrieves data from OS Fifo, blocks if empty
+* @return data
+*/
+FIFO_t OS_Fifo_Get(void){
+	FIFO_t data;
+	OS_QueueGet(&FifoQueue, &data);
+	OS_TRACE_FIFO(TRACE_FIFO_GET, 1);
+	return data;
+}
+
+/** OS_Fifo_GetN
+* Retrieves block of data from OS Fifo, blocks until at least one item
+* @param data where to copy data
+* @param n max number of items
+* @return number of items copied
+*/
+INT32U OS_Fifo_GetN(FIFO_t *data, INT32U n){
+	INT32U got = OS_QueueGetN(&FifoQueue, data, n);
+	OS_TRACE_FIFO(TRACE_FIFO_GET, got);
+	return got;
+}
+
+/** OS_Fifo_Size
+* @brief Gets current size of FiFo
+* @return number of items in FIFO buffer
+*/
+INT32U OS_Fifo_Size(void){
+	return OS_QueueSize(&FifoQueue);
+}
+
+/** OS_Fifo_Dropped
+* @brief Number of items lost because FiFo was full
+* @return dropped count
+*/
+INT32U OS_Fifo_Dropped(void){
+	return OS_QueueDropped(&FifoQueue);
+}
+
+/** OS_MailBoxInit
+* @brief Initializes mailbox object, any number can be made by the application
+* @param box mailbox
+* @param mode MAILBOX_BLOCKING or MAILBOX_OVERWRITE
+*/
+void OS_MailBoxInit(MailBoxType *box, INT8U mode){
+	box->data = 0;
+	box->overwrite = (mode == MAILBOX_OVERWRITE);
+	OS_InitSemaphore(&box->Empty, 1);
+	OS_InitSemaphore(&box->Full,  0);
+}
+
+/** OS_MailBoxSend
+* Enter mail into the Mailbox
+* @brief Blocking mode spins/blocks if the MailBox contains data not yet received,
+* overwrite mode replaces the old data and never blocks
+* @param box mailbox
+* @param data data to put into mailbox
+*/
+void OS_MailBoxSend(MailBoxType *box, INT32U data){
+	if(box->overwrite){
+		INT32U sr = StartCritical();
+		box->data = data;
+		// only signal if reader doesnt already have unread data
+		if(box->Full.Value < 1){
+			OS_Signal(&box->Full);
+		}
+		EndCritical(sr);
+		return;
+	}
+	// wait then signal to send data, wait until mailbox is empty
+	OS_bWait(&box->Empty);
+	box->data = data;
+	OS_bSignal(&box->Full);
+}
+
+/** OS_MailBoxRecv
+* Remove mail from the mailbox
+* @brief Spins/blocks if the MailBox has no new data
+* @param box mailbox
+* @return data from Mailbox
+*/
+INT32U OS_MailBoxRecv(MailBoxType *box){
+	INT32U data;
+	OS_bWait(&box->Full);
+	if(box->overwrite){
+		INT32U sr = StartCritical();
+		data = box->data;
+		// Send between wakeup and here signaled Full for this same value, take it back
+		if(box->Full.Value > 0){
+			box->Full.Value = 0;
+		}
+		EndCritical(sr);
+		return data;
+	}
+	data = box->data;
+	OS_bSignal(&box->Empty);
+	return data;
+}
+
+/** OS_MailBox_Init
+* @brief Initializes communication channel for OS
+*/
+void OS_MailBox_Init(void){
+	OS_MailBoxInit(&MailBox, MAILBOX_BLOCKING);
+}
+
+/** OS_MailBox_Send
+* Enter mail into the OS Mailbox
+* @brief This function will be called from a foreground thread
+* It will spin/block if the MailBox contains data not yet received 
+* @param data data to put into mailbox
+* 
+*/
+void OS_MailBox_Send(INT32U data){
+	OS_MailBoxSend(&MailBox, data);
+}
+
+/** OS_MailBox_Recv
+* Remove mail from the OS mailbox
+* @brief This function will be called from a foreground thread
+* It will spin/block if the MailBox is empty
+* @return data from Mailbox
+* 
+*/
+INT32U OS_MailBox_Recv(void){
+	return OS_MailBoxRecv(&MailBox);
+}
+ 
+/** OS_BusClock
+ *  @return current bus clock in Hz
+*/
+INT32U OS_BusClock(void){
+	return BusClock;
+}
+
+/** OS_SetBusClock
+ *  @brief Change PLL divider at runtime and rescale everything timed in bus cycles
+ *		(SysTick, hardware timers incl. 1 ms tick, UART baud, periodic thread periods)
+ *		OS_Time keeps counting 1/BUS_CLK units, cycles so far are folded in at old clock
+ *  @param sysdiv PLL divider from PLL.h, Bus80MHz to Bus3_125MHz, bus = 400 MHz/(sysdiv+1)
+ *		threads only, waits for UART TX to drain
+ *  @return new bus clock in Hz, 0 if sysdiv out of range or time slice does not fit SysTick
+*/
+INT32U OS_SetBusClock(INT32U sysdiv){
+	INT32U newClock;
+	INT32U now;
+	INT32U sr;
+	if(sysdiv < Bus80MHz || sysdiv > Bus3_125MHz){
+		return 0;
+	}
+	newClock = 400000000/(sysdiv + 1);
+	// time slice must still fit 24 bit SysTick
+	if(!Timer_RescaleFits(newClock)){
+		return 0;
+	}
+	// empty TX at old baud with interrupts on, UART ISR does the draining
+	UART_Drain();
+	sr = StartCritical();
+	// all cycles so far at old rate, new ones at BUS_CLK/newClock = (sysdiv+1)/(400 MHz/BUS_CLK)
+	now = DWT_CYCCNT_R;
+	TimeBase += CyclesToTime(now - CycBase, TimeMul, TimeDiv);
+	CycBase = now;
+	TimeMul = sysdiv + 1;
+	TimeDiv = 400000000/BUS_CLK;
+	TimeSeq++;
+	PLL_Init(sysdiv);
+	OS_TRACE_CLOCK(BusClock, newClock);
+	BusClock = newClock;
+	Timer_Rescale(newClock);
+	UART_SetBusClock(newClock);
+	OS_PeriodicRescale();
+	EndCritical(sr);
+	UART_Release();
+	return newClock;
+}
+
+/** OS_Time64
+ *  @brief Monotonic time since OS_Init, same unit at any bus clock, ISR safe
+ *  @return OS time in 1/BUS_CLK increments (12.5 ns)
+*/
+INT64U OS_Time64(void){
+	INT32U sr = StartCritical();
+	INT64U time;
+	TimeFold();
+	time = TimeBase + CyclesToTime(DWT_CYCCNT_R - CycBase, TimeMul, TimeDiv);
+	EndCritical(sr);
+	return time;
+}
+
+/** OS_Time
+ *  @brief Lock free so profiler and trace can use it with interrupts in any state,
+ *		retries if tick folded time base meanwhile, one subtract at boot clock
+ *  @return OS time in 1/BUS_CLK increments, low 32 bits of OS_Time64 (wraps every 53 s)
+*/
+INT32U OS_Time(void){
+	INT32U seq, base, cycles, mul, div;
+	do{
+		seq = TimeSeq;
+		base = (INT32U)TimeBase;
+		cycles = DWT_CYCCNT_R - CycBase;
+		mul = TimeMul;
+		div = TimeDiv;
+	}while(seq != TimeSeq);
+	if(mul == div){
+		return base + cycles;
+	}
+	return base + CyclesToTime(cycles, mul, div);
+}
+
+/**OS_TimeDifference
+ * @param start
+ * @param stop
+ * @return time difference, correct across one wrap
+*/
+INT32U OS_TimeDifference(INT32U start, INT32U stop){
+	// counter counts up, unsigned subtract handles wrap
+	return stop - start;
+}
+
+/** OS_ClearMsTime
+ *  Clear ms time
+*/
+void OS_ClearMsTime(void){
+	OS_SystemTimeMS  = 0;
+}
+
+/**OS_MsTime
+ *  @return time in ms
+*/
+INT32U OS_ReadMsTime(void){
+	return OS_SystemTimeMS;
+}
+
@@ -1,111 +1,158 @@
-;/** OSAsm.c
- ;* @brief Assembly functions for OS
- ;*/
-        AREA |.text|, CODE, READONLY, ALIGN=2
-        THUMB
-        REQUIRE8
-        PRESERVE8
-
-        EXTERN  RunPt				; currently running thread
-		EXTERN	EndPt				; last TCB pointer 
-		EXTERN  NextRunPt			; point to next thread to run
-        EXPORT  OS_DisableInterrupts
-        EXPORT  OS_EnableInterrupts
-		EXPORT	OS_ASM_Signal
-		EXPORT	OS_ASM_Wait
-        EXPORT  StartOS
-		EXPORT  PendSV_Handler
-
-
-;/** OS_DisableInterrupts
-;* This function will disable interrupts for RTOS
-;*/
-OS_DisableInterrupts
-        CPSID   I
-        BX      LR
-
-
-;/** OS_EnableInterrupts
-;* This function will enable interrupts of RTOS
-;*/
-OS_EnableInterrupts
-        CPSIE   I
-        BX      LR
-
-
-;/** OS_Signal
-;* This function(Spinlock) will signal that a mutual exclusion is taking place in a function
-;* @counter counter
-;*/
-OS_ASM_Signal
-	LDREX	R1, [R0]		; R1 = Counter
-	ADD		R1, #1			; R1++
-	STREX	R2, R1,	[R0]	; Counter = R1, R2 is 0 if successfull
-	CMP		R2, #0			; if (R2 != 0) OS_Signal();
-	BNE 	OS_ASM_Signal		; SUCCESS?
-	BX 		LR				; return
-
-
-;/** OS_Wait
-;* This function(Spinlock) will remove signal for mutual exclusion in function
-;* @counter counter
-;*/
-OS_ASM_Wait
-	LDREX	R1,	[R0]		; R1 = Counter
-	SUBS	R1,	#1			; R1--
-	ITT		PL				; If Then, ok if counter>=0
-	STREXPL	R2,	R1,	[R0]	; Counter = R1, R2 is 0 if successfull
-	CMPPL	R2,	#0			; SUCCESS?
-	BNE		OS_ASM_Wait			; busy wait
-	BX		LR				; return
-
-
-;/** PendSV_Handler
-;* This function will handle context switches for TCB
-;* @author Sikender & Sijin
-;* @date 2/04/2019
-;*/
-PendSV_Handler
-    CPSID   I 					; Make Critical, Use STartcritical?
-    PUSH    {R4-R11}    		; Save regs R4-R11, ISR takes care of R0-R3, SP, LR, PC, PSR
-    LDR     R0, =RunPt			; R0 is ptr to old thread RunPt
-    LDR     R1, [R0]			; RunPt->stackPointer = SP
-    STR     SP, [R1]			; save SP t
-	
-	LDR		R1, =NextRunPt		; Load address of NextRunPtr
-	LDR		R1,	[R1]			; R1 =NextRunPt
-    ;LDR     R1, [R1,#4]		; R1 =RunPt-> nextPtr
-    STR     R1, [R0]  			; RunPt set to R1, RunPt = R1
-	
-    LDR     SP, [R1]			; SP =RunPt-> sp
-    POP     {R4-R11}			; restore regs R4-R11 
-    CPSIE   I					; End Critical, Use EndCritical()?
-    BX      LR 					; The End
-
-
-
-;/** StartOS
-;* This function will start running of OS threads
-;* @author Sikender & Sijin
-;* @date 2/04/2019
-;*/
-regRun RN 2
-StartOS
-	LDR     R0, =RunPt			; R0 is address of RunPt, R0 = &RunPt
-    LDR     R2, [R0]			; R2 =RunPt
-    LDR     SP, [R2]			; SP =RunPt->stackPointer;
-    POP     {R4-R11}			; Restore register, match stack defined in main
-    POP     {R0-R3}				
-    POP     {R12}
-								; ignore LR and PSR from initialized stack
-	ADD		SP, SP, #4			
-    POP     {LR}      			
-	ADD		SP, SP, #4			
-    CPSIE   I 					
-    BX      LR   				; The END
-
-
-;***************End File******************************************
-    ALIGN
-    END
+;/** OSAsm.c
+ ;* @brief Assembly functions for OS
+ ;*/
+        AREA |.text|, CODE, READONLY, ALIGN=2
+        THUMB
+        REQUIRE8
+        PRESERVE8
+
+        EXTERN  RunPt				; currently running thread
+		EXTERN	EndPt				; last TCB pointer 
+		EXTERN  NextRunPt			; point to next thread to run
+		EXTERN	OS_SwitchHook		; cpu time accounting
+		EXTERN	OS_BasePri			; BASEPRI for kernel critical sections
+        EXPORT  OS_DisableInterrupts
+        EXPORT  OS_EnableInterrupts
+		EXPORT	OS_ASM_Signal
+		EXPORT	OS_ASM_Wait
+		EXPORT	OS_ASM_CompareSwap
+		EXPORT	OS_ASM_IPSR
+        EXPORT  StartOS
+		EXPORT  PendSV_Handler
+
+
+;/** OS_DisableInterrupts
+;* This function will disable interrupts for RTOS, BASEPRI so priorities above
+;* OS_MAX_SYSCALL_PRIORITY keep running
+;*/
+OS_DisableInterrupts
+        LDR     R0, =OS_BasePri
+        LDR     R0, [R0]
+        MSR     BASEPRI_MAX, R0
+        BX      LR
+
+
+;/** OS_EnableInterrupts
+;* This function will enable interrupts of RTOS
+;*/
+OS_EnableInterrupts
+        MOVS    R0, #0
+        MSR     BASEPRI, R0
+        BX      LR
+
+
+;/** OS_Signal
+;* This function(Spinlock) will signal that a mutual exclusion is taking place in a function
+;* @counter counter
+;*/
+OS_ASM_Signal
+	LDREX	R1, [R0]		; R1 = Counter
+	ADD		R1, #1			; R1++
+	STREX	R2, R1,	[R0]	; Counter = R1, R2 is 0 if successfull
+	CMP		R2, #0			; if (R2 != 0) OS_Signal();
+	BNE 	OS_ASM_Signal		; SUCCESS?
+	BX 		LR				; return
+
+
+;/** OS_Wait
+;* This function(Spinlock) will remove signal for mutual exclusion in function
+;* @counter counter
+;*/
+OS_ASM_Wait
+	LDREX	R1,	[R0]		; R1 = Counter
+	SUBS	R1,	#1			; R1--
+	ITT		PL				; If Then, ok if counter>=0
+	STREXPL	R2,	R1,	[R0]	; Counter = R1, R2 is 0 if successfull
+	CMPPL	R2,	#0			; SUCCESS?
+	BNE		OS_ASM_Wait			; busy wait
+	BX		LR				; return
+
+
+;/** OS_ASM_CompareSwap
+;* Lock free compare and swap, retries only if reservation lost to an ISR
+;* @param R0 address, R1 expected value, R2 new value
+;* @return R0 1 if swapped, 0 if value was not expected
+;*/
+OS_ASM_CompareSwap
+	LDREX	R3, [R0]		; R3 = *addr
+	CMP		R3, R1			; still expected value?
+	BNE		CompareSwapFail	; someone else got it
+	STREX	R3, R2, [R0]	; *addr = R2, R3 is 0 if successfull
+	CMP		R3, #0			; SUCCESS?
+	BNE		OS_ASM_CompareSwap	; reservation lost, retry
+	MOVS	R0, #1			; return 1
+	BX		LR
+CompareSwapFail
+	CLREX					; drop reservation
+	MOVS	R0, #0			; return 0
+	BX		LR
+
+
+;/** OS_ASM_IPSR
+;* Read exception number, 0 in thread mode
+;* @return R0 IPSR
+;*/
+OS_ASM_IPSR
+	MRS		R0, IPSR		; R0 = active exception
+	BX		LR
+
+
+;/** PendSV_Handler
+;* This function will handle context switches for TCB
+;* @author Sikender & Sijin
+;* @date 2/04/2019
+;*/
+PendSV_Handler
+	LDR		R2, =OS_BasePri		; Make Critical, mask kernel aware ISRs only
+	LDR		R2, [R2]
+	MSR		BASEPRI, R2
+    PUSH    {R4-R11}    		; Save regs R4-R11, ISR takes care of R0-R3, SP, LR, PC, PSR
+    LDR     R0, =RunPt			; R0 is ptr to old thread RunPt
+    LDR     R1, [R0]			; RunPt->stackPointer = SP
+    STR     SP, [R1]			; save SP t
+	
+	PUSH	{R0, LR}			; keep &RunPt and EXC_RETURN, 8 byte aligned
+	BL		OS_SwitchHook		; charge run time to old thread
+	POP		{R0, LR}
+	
+	LDR		R1, =NextRunPt		; Load address of NextRunPtr
+	LDR		R1,	[R1]			; R1 =NextRunPt
+    ;LDR     R1, [R1,#4]		; R1 =RunPt-> nextPtr
+    STR     R1, [R0]  			; RunPt set to R1, RunPt = R1
+	
+    LDR     SP, [R1]			; SP =RunPt-> sp
+    POP     {R4-R11}			; restore regs R4-R11 
+	MOVS	R2, #0				; End Critical, PendSV is lowest so mask was 0
+	MSR		BASEPRI, R2
+    BX      LR 					; The End
+
+
+
+;/** StartOS
+;* This function will start running of OS threads
+;* @author Sikender & Sijin
+;* @date 2/04/2019
+;*/
+regRun RN 2
+StartOS
+	CPSID	I					; no ISR until first thread stack is up
+	MOVS	R0, #0				; drop BASEPRI left by OS_Init
+	MSR		BASEPRI, R0
+	LDR     R0, =RunPt			; R0 is address of RunPt, R0 = &RunPt
+    LDR     R2, [R0]			; R2 =RunPt
+    LDR     SP, [R2]			; SP =RunPt->stackPointer;
+    POP     {R4-R11}			; Restore register, match stack defined in main
+    POP     {R0-R3}				
+    POP     {R12}
+								; ignore LR and PSR from initialized stack
+	ADD		SP, SP, #4			
+    POP     {LR}      			
+	ADD		SP, SP, #4			
+    CPSIE   I 					
+    BX      LR   				; The END
+
+
+;***************End File******************************************
+    ALIGN
+    END
 		
\ No newline at end of file
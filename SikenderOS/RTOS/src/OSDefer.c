@@ -0,0 +1,81 @@
+/**
+* @file OSDefer.c
+* @brief Deferred interrupt work (bottom halves), ISRs queue function plus argument and
+*	a kernel worker thread at DEFER_PRIORITY runs it
+*
+* Queue is the lock free MPSC FIFO from FIFO.h so any number of ISRs can post at once
+* without masking, worker is the only consumer. Deferred work runs as a thread, more
+* urgent interrupts preempt it and it may use any OS call, but blocking in it stalls
+* all other deferred work.
+*/
+#include "startup.h"
+#include "OS.h"
+#include "FIFO.h"
+
+
+AddMpscFifo(Defer, DEFER_SIZE, WorkType, 1, 0)
+
+/*! @var Sema4Type DeferReady
+    @brief counts queued items, worker blocks here
+*/
+static Sema4Type DeferReady;
+
+/*! @var INT32U DeferDropped
+    @brief items lost because queue was full, only changed with OS_ASM_CompareSwap
+*/
+static volatile INT32U DeferDropped;
+
+
+/** DeferWorker
+* @brief Kernel worker thread, runs queued items in order
+*/
+static void DeferWorker(void){
+	WorkType work;
+	while(1){
+		OS_Wait(&DeferReady);
+		if(DeferFifo_Get(&work)){
+			work.fn(work.arg);
+		}
+	}
+}
+
+/** OS_DeferInit
+* @brief Empty queue and add worker thread, called by OS_Init
+*/
+void OS_DeferInit(void){
+	DeferFifo_Init();
+	OS_InitSemaphore(&DeferReady, 0);
+	DeferDropped = 0;
+	OS_AddThread(&DeferWorker, DEFER_PRIORITY);
+}
+
+/** OS_Defer
+* @brief Queue work for worker thread, queue is lock free but waking the worker
+*	takes BASEPRI, safe from threads and any ISR at or below OS_MAX_SYSCALL_PRIORITY
+* @param fn function to run
+* @param arg passed to fn
+* @return 1 queued, 0 queue full (counted as dropped)
+*/
+INT8 OS_Defer(void(*fn)(void *arg), void *arg){
+	WorkType work;
+	INT32U dropped;
+	work.fn = fn;
+	work.arg = arg;
+	if(DeferFifo_Put(work) == 0){
+		// nested ISRs can both drop, count with CAS so neither is lost
+		do{
+			dropped = DeferDropped;
+		}while(!OS_ASM_CompareSwap(&DeferDropped, dropped, dropped + 1));
+		return 0;
+	}
+	OS_Signal(&DeferReady);
+	return 1;
+}
+
+/** OS_DeferDropped
+* @brief Number of items OS_Defer could not queue since OS_Init
+* @return dropped count
+*/
+INT32U OS_DeferDropped(void){
+	return DeferDropped;
+}
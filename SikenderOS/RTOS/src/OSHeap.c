@@ -0,0 +1,312 @@
+/**
+* @file OSHeap.c
+* @brief Two level segregated fit (TLSF) heap for variable size buffers, malloc and free are O(1)
+* 
+* Free blocks are kept in FL x SL lists. First level is power of 2 size class,
+* second level splits each class into HEAP_SL_COUNT linear ranges. Two bitmaps
+* say which lists have blocks so a fit is found with two find-first-set ops
+* instead of walking lists.
+*/
+#include <stddef.h>
+#include "startup.h"
+#include "OS.h"
+
+
+#define HEAP_ALIGN_LOG2		3							// 8 byte alignment (AAPCS)
+#define HEAP_ALIGN			(1U << HEAP_ALIGN_LOG2)
+#define HEAP_SL_LOG2		4							// 16 second level lists
+#define HEAP_SL_COUNT		(1U << HEAP_SL_LOG2)
+#define HEAP_FL_SHIFT		(HEAP_SL_LOG2 + HEAP_ALIGN_LOG2)
+#define HEAP_FL_MAX			17							// blocks up to 128K
+#define HEAP_FL_COUNT		(HEAP_FL_MAX - HEAP_FL_SHIFT + 1)
+#define HEAP_SMALL_BLOCK	(1U << HEAP_FL_SHIFT)		// below this, first level 0 is linear
+
+#define HEAP_BLOCK_FREE		0x1U						// size flag, this block free
+#define HEAP_PREV_FREE		0x2U						// size flag, block before this one free
+#define HEAP_SIZE_MASK		(~(HEAP_ALIGN - 1))
+
+#if defined(__CC_ARM)
+#define HeapFls(x)	(31 - (INT32)__clz(x))
+#else
+#define HeapFls(x)	(31 - (INT32)__builtin_clz(x))
+#endif
+#define HeapFfs(x)	HeapFls((x) & (~(x) + 1))
+
+
+/** HeapBlock
+ * Header in front of every block, free list links live in the payload of free blocks
+*/
+struct HeapBlock{
+	struct HeapBlock *prevPhys;		/**< block before this one in memory */
+	INT32U size;					/**< payload bytes | flags */
+	struct HeapBlock *nextFree;		/**< only valid while free */
+	struct HeapBlock *prevFree;		/**< only valid while free */
+};
+typedef struct HeapBlock HeapBlockType;
+
+#define HEAP_HEADER			offsetof(HeapBlockType, nextFree)	// prevPhys + size, payload starts after
+#define HEAP_MIN_BLOCK		(sizeof(HeapBlockType) - HEAP_HEADER)
+
+
+/*! @var INT64U HeapArena
+    @brief memory handed out by OS_Malloc, INT64U keeps it 8 byte aligned
+*/
+static INT64U HeapArena[HEAP_SIZE/8];
+
+/*! @var INT32U HeapFlBitmap
+    @brief bit set for each first level with free blocks
+*/
+static INT32U HeapFlBitmap;
+
+/*! @var INT32U HeapSlBitmap
+    @brief bit set for each second level list with free blocks
+*/
+static INT32U HeapSlBitmap[HEAP_FL_COUNT];
+
+/*! @var HeapBlockType HeapFree
+    @brief heads of free lists
+*/
+static HeapBlockType *HeapFree[HEAP_FL_COUNT][HEAP_SL_COUNT];
+
+/*! @var INT32U HeapUsed
+    @brief payload bytes handed out
+*/
+static INT32U HeapUsed;
+
+/*! @var INT32U HeapFailures
+    @brief OS_Malloc calls that found no fit
+*/
+static INT32U HeapFailures;
+
+/*! @var Sema4Type HeapMutex
+    @brief kernel lock so threads can share heap
+*/
+static Sema4Type HeapMutex;
+
+
+/** BlockSize
+ * @brief payload size without flags
+*/
+static INT32U BlockSize(HeapBlockType *block){
+	return block->size & HEAP_SIZE_MASK;
+}
+
+/** BlockNext
+ * @brief physical block after this one, arena ends with used 0 size sentinel
+*/
+static HeapBlockType* BlockNext(HeapBlockType *block){
+	return (HeapBlockType*)((INT8U*)block + HEAP_HEADER + BlockSize(block));
+}
+
+/** MappingInsert
+ * @brief find list a block of size belongs in
+*/
+static void MappingInsert(INT32U size, INT32 *fl, INT32 *sl){
+	if(size < HEAP_SMALL_BLOCK){
+		*fl = 0;
+		*sl = size / (HEAP_SMALL_BLOCK / HEAP_SL_COUNT);
+	}else{
+		*fl = HeapFls(size);
+		*sl = (size >> (*fl - HEAP_SL_LOG2)) ^ HEAP_SL_COUNT;
+		*fl -= (HEAP_FL_SHIFT - 1);
+	}
+}
+
+/** MappingSearch
+ * @brief find first list whose blocks are all big enough for size
+*/
+static void MappingSearch(INT32U size, INT32 *fl, INT32 *sl){
+	if(size >= HEAP_SMALL_BLOCK){
+		size += (1U << (HeapFls(size) - HEAP_SL_LOG2)) - 1;
+	}
+	MappingInsert(size, fl, sl);
+}
+
+/** InsertFree
+ * @brief push block on head of its list, set bitmaps
+*/
+static void InsertFree(HeapBlockType *block){
+	INT32 fl, sl;
+	MappingInsert(BlockSize(block), &fl, &sl);
+	block->nextFree = HeapFree[fl][sl];
+	block->prevFree = 0;
+	if(HeapFree[fl][sl] != 0){
+		HeapFree[fl][sl]->prevFree = block;
+	}
+	HeapFree[fl][sl] = block;
+	HeapFlBitmap |= (1U << fl);
+	HeapSlBitmap[fl] |= (1U << sl);
+	block->size |= HEAP_BLOCK_FREE;
+	BlockNext(block)->prevPhys = block;
+	BlockNext(block)->size |= HEAP_PREV_FREE;
+}
+
+/** RemoveFree
+ * @brief unlink block from its list, clear bitmaps if list now empty
+*/
+static void RemoveFree(HeapBlockType *block){
+	INT32 fl, sl;
+	MappingInsert(BlockSize(block), &fl, &sl);
+	if(block->prevFree != 0){
+		block->prevFree->nextFree = block->nextFree;
+	}else{
+		HeapFree[fl][sl] = block->nextFree;
+	}
+	if(block->nextFree != 0){
+		block->nextFree->prevFree = block->prevFree;
+	}
+	if(HeapFree[fl][sl] == 0){
+		HeapSlBitmap[fl] &= ~(1U << sl);
+		if(HeapSlBitmap[fl] == 0){
+			HeapFlBitmap &= ~(1U << fl);
+		}
+	}
+	block->size &= ~HEAP_BLOCK_FREE;
+	BlockNext(block)->size &= ~HEAP_PREV_FREE;
+}
+
+/** FindFree
+ * @brief two bitmap lookups for first non empty list at or above fl/sl
+*/
+static HeapBlockType* FindFree(INT32 fl, INT32 sl){
+	INT32U slMap, flMap;
+	if(fl >= HEAP_FL_COUNT){
+		return 0;
+	}
+	slMap = HeapSlBitmap[fl] & (~0U << sl);
+	if(slMap == 0){
+		// nothing big enough in this class, go up a class
+		flMap = HeapFlBitmap & (~0U << (fl + 1));
+		if(flMap == 0){
+			return 0;
+		}
+		fl = HeapFfs(flMap);
+		slMap = HeapSlBitmap[fl];
+	}
+	sl = HeapFfs(slMap);
+	return HeapFree[fl][sl];
+}
+
+/** OS_HeapInit
+* @brief Turn arena into one big free block followed by a sentinel
+*/
+void OS_HeapInit(void){
+	HeapBlockType *block = (HeapBlockType*)HeapArena;
+	HeapBlockType *sentinel;
+	INT32U fl;
+	HeapFlBitmap = 0;
+	for(fl = 0; fl < HEAP_FL_COUNT; fl++){
+		HeapSlBitmap[fl] = 0;
+		for(INT32U sl = 0; sl < HEAP_SL_COUNT; sl++){
+			HeapFree[fl][sl] = 0;
+		}
+	}
+	HeapUsed = 0;
+	HeapFailures = 0;
+	OS_InitSemaphore(&HeapMutex, 1);
+	
+	block->prevPhys = 0;
+	block->size = (sizeof(HeapArena) - 2*HEAP_HEADER) & HEAP_SIZE_MASK;
+	sentinel = BlockNext(block);
+	sentinel->size = 0;
+	InsertFree(block);
+}
+
+/** OS_Malloc
+* @brief Good fit allocation in bounded time, split off whats left over
+* @param size bytes needed
+* @return pointer to memory, 0 if no fit
+*/
+void* OS_Malloc(INT32U size){
+	HeapBlockType *block, *rest;
+	INT32 fl, sl;
+	if(size == 0 || size > sizeof(HeapArena)){
+		return 0;
+	}
+	size = (size + HEAP_ALIGN - 1) & HEAP_SIZE_MASK;
+	if(size < HEAP_MIN_BLOCK){
+		size = HEAP_MIN_BLOCK;
+	}
+	
+	OS_Wait(&HeapMutex);
+	MappingSearch(size, &fl, &sl);
+	block = FindFree(fl, sl);
+	if(block == 0){
+		HeapFailures++;
+		OS_Signal(&HeapMutex);
+		return 0;
+	}
+	RemoveFree(block);
+	// split if leftover can hold a block of its own
+	if(BlockSize(block) >= size + HEAP_HEADER + HEAP_MIN_BLOCK){
+		rest = (HeapBlockType*)((INT8U*)block + HEAP_HEADER + size);
+		rest->size = BlockSize(block) - size - HEAP_HEADER;
+		rest->prevPhys = block;
+		block->size = size | (block->size & HEAP_PREV_FREE);
+		InsertFree(rest);
+	}
+	HeapUsed += BlockSize(block);
+	OS_Signal(&HeapMutex);
+	return (INT8U*)block + HEAP_HEADER;
+}
+
+/** OS_Free
+* @brief Merge with free neighbours in memory and put back on a free list, O(1)
+* @param ptr memory from OS_Malloc, 0 is ignored
+*/
+void OS_Free(void *ptr){
+	HeapBlockType *block, *next;
+	if(ptr == 0){
+		return;
+	}
+	block = (HeapBlockType*)((INT8U*)ptr - HEAP_HEADER);
+	
+	OS_Wait(&HeapMutex);
+	HeapUsed -= BlockSize(block);
+	// merge with block before
+	if(block->size & HEAP_PREV_FREE){
+		HeapBlockType *prev = block->prevPhys;
+		RemoveFree(prev);
+		prev->size += HEAP_HEADER + BlockSize(block);
+		block = prev;
+	}
+	// merge with block after
+	next = BlockNext(block);
+	if(next->size & HEAP_BLOCK_FREE){
+		RemoveFree(next);
+		block->size += HEAP_HEADER + BlockSize(next);
+	}
+	BlockNext(block)->prevPhys = block;
+	InsertFree(block);
+	OS_Signal(&HeapMutex);
+}
+
+/** OS_HeapGetStats
+* @brief Walk arena to report fragmentation, O(N) so keep it out of real time paths
+* @param stats filled in with snapshot
+*/
+void OS_HeapGetStats(HeapStatsType *stats){
+	HeapBlockType *block = (HeapBlockType*)HeapArena;
+	stats->totalBytes = sizeof(HeapArena);
+	stats->freeBytes = 0;
+	stats->largestFree = 0;
+	stats->freeBlocks = 0;
+	
+	OS_Wait(&HeapMutex);
+	stats->usedBytes = HeapUsed;
+	stats->failures = HeapFailures;
+	while(BlockSize(block) != 0){
+		if(block->size & HEAP_BLOCK_FREE){
+			stats->freeBlocks++;
+			stats->freeBytes += BlockSize(block);
+			if(BlockSize(block) > stats->largestFree){
+				stats->largestFree = BlockSize(block);
+			}
+		}
+		block = BlockNext(block);
+	}
+	OS_Signal(&HeapMutex);
+	// 0: all free memory in one block, near 100: free memory in tiny pieces
+	stats->fragmentation = (stats->freeBytes == 0) ? 0 : 
+		100 - (stats->largestFree*100)/stats->freeBytes;
+}
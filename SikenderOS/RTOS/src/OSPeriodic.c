@@ -0,0 +1,233 @@
+/**
+* @file OSPeriodic.c
+* @brief Periodic background threads and their jitter statistics
+* 
+* First 8 periodic threads get own hardware timer, rest run on the timing wheel.
+* Every activation is stamped with OS_Time and compared to ideal time (first
+* activation + n*period), deviation goes into min/max and log2 histogram.
+* Both are in OS_Time units so stats stay valid across OS_SetBusClock.
+*/
+#include <stddef.h>
+#include "cpu.h"
+#include "startup.h"
+#include "Timer.h"
+#include "OS.h"
+
+
+#define NUMHWPERIODIC 8
+
+/** PeriodicTask
+ * One periodic thread, hardware timer or wheel timer
+*/
+struct PeriodicTask{
+	void(*task)(void);		/**< user task */
+	INT32U period;			/**< OS_Time units between activations, same at any bus clock */
+	INT32U ideal;			/**< OS_Time activation should happen at */
+	INT8U started;			/**< 0 until first activation sets ideal */
+	INT8U id;				/**< add order, same id OS_GetJitter takes */
+	JitterType jitter;		/**< stats */
+	TimerType timer;		/**< wheel entry, wheel tasks only */
+	struct PeriodicTask *next;	/**< LL in add order, index is id */
+};
+typedef struct PeriodicTask PeriodicTaskType;
+
+static PeriodicTaskType HwPeriodic[NUMHWPERIODIC];
+static PeriodicTaskType *PeriodicList;
+static PeriodicTaskType **PeriodicTail = &PeriodicList;
+static INT32U NumPeriodic;
+
+
+/** JitterClear
+* @brief Reset stats
+* @param jitter stats
+*/
+static void JitterClear(JitterType *jitter){
+	jitter->count = 0;
+	jitter->min = 0x7FFFFFFF;
+	jitter->max = -0x7FFFFFFF - 1;
+	for(INT32U i = 0; i < JITTER_BUCKETS; i++){
+		jitter->buckets[i] = 0;
+	}
+}
+
+/** PeriodicSetup
+* @brief Fill in new periodic task, stats cleared
+* @param p periodic task
+* @param task user task
+* @param period bus cycles at current clock
+*/
+static void PeriodicSetup(PeriodicTaskType *p, void(*task)(void), INT32U period){
+	p->task = task;
+	p->period = ((INT64U)period*BUS_CLK + OS_BusClock()/2)/OS_BusClock();
+	p->started = 0;
+	p->id = NumPeriodic;
+	JitterClear(&p->jitter);
+	p->next = 0;
+}
+
+/** PeriodicRun
+* @brief Stamp activation, record deviation from ideal, run task
+* @param p periodic task
+*/
+static void PeriodicRun(PeriodicTaskType *p){
+	INT32U now = OS_Time();
+	INT32 dev;
+	INT32U mag;
+	INT32U bucket = 0;
+	if(!p->started){
+		p->ideal = now;
+		p->started = 1;
+	}
+	dev = (INT32)(now - p->ideal);
+	p->ideal += p->period;
+	if(dev < p->jitter.min){
+		p->jitter.min = dev;
+	}
+	if(dev > p->jitter.max){
+		p->jitter.max = dev;
+	}
+	// bucket k holds |dev| in [2^(k-1), 2^k), last one everything bigger
+	mag = (dev < 0) ? -dev : dev;
+	while(mag && bucket < JITTER_BUCKETS - 1){
+		mag >>= 1;
+		bucket++;
+	}
+	p->jitter.buckets[bucket]++;
+	p->jitter.count++;
+	// own event pair, timer ISR (or wheel tick) already traces its enter/exit
+	OS_TRACE_PERIODIC(TRACE_PERIODIC_START, p->id);
+	p->task();
+	OS_TRACE_PERIODIC(TRACE_PERIODIC_END, p->id);
+}
+
+// hardware timers cant pass argument, one stub per slot
+static void HwPeriodic0(void){ PeriodicRun(&HwPeriodic[0]); }
+static void HwPeriodic1(void){ PeriodicRun(&HwPeriodic[1]); }
+static void HwPeriodic2(void){ PeriodicRun(&HwPeriodic[2]); }
+static void HwPeriodic3(void){ PeriodicRun(&HwPeriodic[3]); }
+static void HwPeriodic4(void){ PeriodicRun(&HwPeriodic[4]); }
+static void HwPeriodic5(void){ PeriodicRun(&HwPeriodic[5]); }
+static void HwPeriodic6(void){ PeriodicRun(&HwPeriodic[6]); }
+static void HwPeriodic7(void){ PeriodicRun(&HwPeriodic[7]); }
+static void (*const HwStubs[NUMHWPERIODIC])(void) = {
+	&HwPeriodic0, &HwPeriodic1, &HwPeriodic2, &HwPeriodic3,
+	&HwPeriodic4, &HwPeriodic5, &HwPeriodic6, &HwPeriodic7
+};
+static INT32U NumHwPeriodic;
+
+/** WheelPeriodicExpire
+* @brief Wheel expire hook, rearm one period after this expire then run
+* @param timer timer inside PeriodicTask
+*/
+static void WheelPeriodicExpire(TimerType *timer){
+	PeriodicTaskType *p = (PeriodicTaskType*)((INT8U*)timer - offsetof(PeriodicTaskType, timer));
+	INT32U sr = StartCritical();
+	OS_WheelAdd(timer, timer->period);
+	EndCritical(sr);
+	PeriodicRun(p);
+}
+
+/** OS_AddPeriodicThread
+ * @brief Adds periodic background thread. Cannot spin, sleep, die, rest, etc. cause it's ISR
+			No ID for this thread, must have mid-high priority to run properly
+			First 8 get free hardware timer from Timer_Alloc, rest go on 1 ms wheel (period rounded to ms, priority of Timer0A)
+ * @param task task to run in background
+ * @param  period bus cycles
+ * @param  priority 5-0 only, else you'll break OS :(, raised to OS_MAX_SYSCALL_PRIORITY
+ * @return successful - 1, Fail - 0
+*/
+INT8 OS_AddPeriodicThread(void(*task)(void), INT32U period, INT32U priority){ 
+	PeriodicTaskType *p = 0;
+	INT32U ticks;
+	INT32U sr;
+	
+	// task may signal and use FIFOs, must stay under kernel mask
+	if(priority < OS_MAX_SYSCALL_PRIORITY){
+		priority = OS_MAX_SYSCALL_PRIORITY;
+	}
+	// own hardware timer while stubs and free timers last
+	if(NumHwPeriodic < NUMHWPERIODIC){
+		p = &HwPeriodic[NumHwPeriodic];
+		PeriodicSetup(p, task, period);
+		if(Timer_Alloc(HwStubs[NumHwPeriodic], period, priority) >= 0){
+			NumHwPeriodic++;
+		}else{
+			p = 0;
+		}
+	}
+	// no more hardware timers dawg, rest go on the wheel
+	if(p == 0){
+		p = (PeriodicTaskType*)OS_Malloc(sizeof(PeriodicTaskType));
+		if(p == 0){
+			return 0;
+		}
+		ticks = (period + TIME_1MS/2)/TIME_1MS;
+		ticks = (ticks == 0) ? 1 : ticks;
+		PeriodicSetup(p, task, ticks*TIME_1MS);
+		OS_TimerCreate(&p->timer, task, ticks, 1);
+		p->timer.expireFn = &WheelPeriodicExpire;
+		OS_TimerStart(&p->timer);
+	}
+	sr = StartCritical();
+	*PeriodicTail = p;
+	PeriodicTail = &p->next;
+	NumPeriodic++;
+	EndCritical(sr);
+	return 1;
+}
+
+/** OS_PeriodicCount
+* @brief Number of periodic threads added, ids are 0 to count-1 in add order
+* @return count
+*/
+INT32U OS_PeriodicCount(void){
+	return NumPeriodic;
+}
+
+/** OS_GetJitter
+* @brief Copy jitter stats of periodic thread
+* @param id periodic thread, 0 is first added
+* @param stats output
+* @return 1 if id valid, 0 if not
+*/
+INT8 OS_GetJitter(INT32U id, JitterType *stats){
+	PeriodicTaskType *p = PeriodicList;
+	INT32U sr;
+	while(p && id){
+		p = p->next;
+		id--;
+	}
+	if(p == 0){
+		return 0;
+	}
+	sr = StartCritical();
+	*stats = p->jitter;
+	EndCritical(sr);
+	return 1;
+}
+
+/** OS_PeriodicRescale
+* @brief Restart ideal time after bus clock change, period is kept in OS_Time units so
+*	it still holds but hardware timer reloads were rounded again by Timer_Rescale
+*/
+void OS_PeriodicRescale(void){
+	INT32U sr;
+	for(PeriodicTaskType *p = PeriodicList; p; p = p->next){
+		sr = StartCritical();
+		p->started = 0;
+		EndCritical(sr);
+	}
+}
+
+/** OS_ClearJitter
+* @brief Reset jitter stats of all periodic threads, ideal time restarts at next activation
+*/
+void OS_ClearJitter(void){
+	INT32U sr;
+	for(PeriodicTaskType *p = PeriodicList; p; p = p->next){
+		sr = StartCritical();
+		JitterClear(&p->jitter);
+		p->started = 0;
+		EndCritical(sr);
+	}
+}
@@ -0,0 +1,148 @@
+/**
+* @file OSPool.c
+* @brief Fixed size block pools for OS, O(1) alloc and free through free list kept in the blocks
+* 
+*/
+#include "startup.h"
+#include "OS.h"
+
+
+/*! @var PoolType Pools
+    @brief Control blocks for pools, block storage is owned by the caller
+*/
+static PoolType Pools[NUMPOOLS];
+
+/*! @var INT32U NumOfPools
+    @brief number of pools created
+*/
+static INT32U NumOfPools = 0;
+
+
+/** OS_PoolCreate
+* @brief Grab a pool control block and chain all blocks into the free list
+* @param buf storage for numBlocks blocks
+* @param blockSize size of block in bytes, rounded up to 4 so free list ptrs stay aligned
+* @param numBlocks number of blocks
+* @return pool handle, 0 if fail
+*/
+PoolType* OS_PoolCreate(void *buf, INT32U blockSize, INT32U numBlocks){
+	PoolType *pool;
+	INT8U *block;
+	if(buf == 0 || blockSize == 0 || numBlocks == 0){
+		return 0;
+	}
+	INT32U sr = StartCritical();
+	// out of control blocks, bump NUMPOOLS
+	if(NumOfPools >= NUMPOOLS){
+		EndCritical(sr);
+		return 0;
+	}
+	pool = &Pools[NumOfPools++];
+	EndCritical(sr);
+	
+	blockSize = (blockSize + 3) & ~3U;
+	pool->buffer = (INT8U*)buf;
+	pool->blockSize = blockSize;
+	pool->numBlocks = numBlocks;
+	pool->numFree = numBlocks;
+	pool->highWater = 0;
+	pool->failures = 0;
+	// each free block stores address of next free block
+	block = pool->buffer;
+	for(INT32U i = 0; i < numBlocks - 1; i++){
+		*(void**)block = block + blockSize;
+		block += blockSize;
+	}
+	*(void**)block = 0;
+	pool->freeList = pool->buffer;
+	OS_InitSemaphore(&pool->Free, numBlocks);
+	return pool;
+}
+
+/** PoolTake
+* @brief Pop block off head of free list, caller already holds a count of Free
+* @param pool pool handle
+* @return block
+*/
+static void* PoolTake(PoolType *pool){
+	void *block;
+	INT32U sr = StartCritical();
+	block = pool->freeList;
+	pool->freeList = *(void**)block;
+	pool->numFree--;
+	if(pool->numBlocks - pool->numFree > pool->highWater){
+		pool->highWater = pool->numBlocks - pool->numFree;
+	}
+	EndCritical(sr);
+	return block;
+}
+
+/** PoolFail
+* @brief count alloc that came back empty handed
+* @param pool pool handle
+*/
+static void PoolFail(PoolType *pool){
+	INT32U sr = StartCritical();
+	pool->failures++;
+	EndCritical(sr);
+}
+
+/** OS_PoolAlloc
+* @brief Pop block off head of free list, O(1)
+* @param pool pool handle
+* @return block, 0 if pool empty
+*/
+void* OS_PoolAlloc(PoolType *pool){
+	if(OS_TryWait(&pool->Free) == 0){
+		PoolFail(pool);
+		return 0;
+	}
+	return PoolTake(pool);
+}
+
+/** OS_PoolAllocTimeout
+* @brief Pop block off free list, thread blocks on Free while pool is empty
+* @param pool pool handle
+* @param timeout max time to block (ms)
+* @return block, 0 if timed out
+*/
+void* OS_PoolAllocTimeout(PoolType *pool, INT32U timeout){
+	if(OS_WaitTimeout(&pool->Free, timeout) == 0){
+		PoolFail(pool);
+		return 0;
+	}
+	return PoolTake(pool);
+}
+
+/** OS_PoolFree
+* @brief Push block onto head of free list, O(1)
+* @param pool pool block came from
+* @param block block to free
+*/
+void OS_PoolFree(PoolType *pool, void *block){
+	if(block == 0){
+		return;
+	}
+	INT32U sr = StartCritical();
+	*(void**)block = pool->freeList;
+	pool->freeList = block;
+	pool->numFree++;
+	EndCritical(sr);
+	// wake thread waiting in OS_PoolAllocTimeout
+	OS_Signal(&pool->Free);
+}
+
+/** OS_PoolGetStats
+* @brief Copy pool counters under critical so they match each other
+* @param pool pool handle
+* @param stats filled in with snapshot
+*/
+void OS_PoolGetStats(PoolType *pool, PoolStatsType *stats){
+	INT32U sr = StartCritical();
+	stats->blockSize = pool->blockSize;
+	stats->numBlocks = pool->numBlocks;
+	stats->numFree = pool->numFree;
+	stats->highWater = pool->highWater;
+	stats->failures = pool->failures;
+	EndCritical(sr);
+}
@@ -0,0 +1,177 @@
+/**
+* @file OSProfile.c
+* @brief Critical section profiler, compiled in with OS_CSPROFILE
+*
+* OS.h maps StartCritical/EndCritical and the interrupt enable/disable calls onto the
+* OS_CS* functions here. Outermost section (interrupts were on) is timed with the DWT
+* cycle counter and charged to return address of the caller, so nested sections count
+* once against whoever turned interrupts off. Look sites up in the linker map.
+* Wake-to-run latency is kept per thread in OS.c, both read by "os -crit".
+*/
+#include "OS.h"
+
+#if OS_CSPROFILE
+
+// real primitives, undo OS.h mapping in this file only
+#undef StartCritical
+#undef EndCritical
+#undef DisableInterrupts
+#undef EnableInterrupts
+#undef OS_DisableInterrupts
+#undef OS_EnableInterrupts
+#include "startup.h"
+
+#ifdef __CC_ARM
+#define CALL_SITE()	__return_address()
+#else
+#define CALL_SITE()	__builtin_return_address(0)
+#endif
+
+// in OS.c
+void OS_WakeClear(void);
+
+/*! @var CritStatsType CritSites
+    @brief one entry per call site, last one also takes sites that did not fit
+*/
+static CritStatsType CritSites[CS_SITES];
+
+/*! @var INT32U CritStart
+    @brief OS_Time when interrupts went off
+*/
+static INT32U CritStart;
+
+/*! @var void* CritSite
+    @brief caller that turned interrupts off
+*/
+static void *CritSite;
+
+/*! @var INT8U CritActive
+    @brief 1 while a timed section is open
+*/
+static INT8U CritActive;
+
+
+/** CritOpen
+* @brief Start timing, interrupts already off
+* @param site caller return address
+*/
+static void CritOpen(void *site){
+	CritStart = OS_Time();
+	CritSite = site;
+	CritActive = 1;
+}
+
+/** CritClose
+* @brief Charge open section to its call site, interrupts still off
+*/
+static void CritClose(void){
+	INT32U cycles = OS_Time() - CritStart;
+	CritStatsType *entry = CritSites;
+	CritActive = 0;
+	// find site or first free, table full lands on last entry
+	while(entry < &CritSites[CS_SITES - 1] && entry->count && entry->site != CritSite){
+		entry++;
+	}
+	if(entry->count == 0){
+		entry->site = CritSite;
+	}else if(entry->site != CritSite){
+		entry->site = 0;
+	}
+	entry->count++;
+	entry->totalCycles += cycles;
+	if(cycles > entry->maxCycles){
+		entry->maxCycles = cycles;
+	}
+}
+
+/** OS_CSStart
+* @brief StartCritical that opens timed section if interrupts were on
+* @return previous BASEPRI
+*/
+INT32U OS_CSStart(void){
+	void *site = CALL_SITE();
+	INT32U sr = StartCritical();
+	if(sr == 0){
+		CritOpen(site);
+	}
+	return sr;
+}
+
+/** OS_CSEnd
+* @brief EndCritical that closes section if it turns interrupts back on
+* @param sr from OS_CSStart
+*/
+void OS_CSEnd(INT32U sr){
+	if(sr == 0 && CritActive){
+		CritClose();
+	}
+	EndCritical(sr);
+}
+
+/** OS_CSDisable
+* @brief DisableInterrupts that opens timed section if interrupts were on
+*/
+void OS_CSDisable(void){
+	void *site = CALL_SITE();
+	if(StartCritical() == 0){
+		CritOpen(site);
+	}
+}
+
+/** OS_CSEnable
+* @brief EnableInterrupts that closes open section
+*/
+void OS_CSEnable(void){
+	if(CritActive){
+		CritClose();
+	}
+	EnableInterrupts();
+}
+
+/** OS_CSWorst
+* @brief Copy call sites sorted by longest section
+* @param out array of max entries
+* @param max size of out
+* @return entries copied
+*/
+INT32U OS_CSWorst(CritStatsType *out, INT32U max){
+	INT32U n = 0;
+	INT32U i, j;
+	INT32U sr = StartCritical();
+	// insertion sort into out, table is small
+	for(i = 0; i < CS_SITES; i++){
+		if(CritSites[i].count == 0){
+			continue;
+		}
+		j = n < max ? n++ : max;
+		while(j > 0 && out[j-1].maxCycles < CritSites[i].maxCycles){
+			if(j < max){
+				out[j] = out[j-1];
+			}
+			j--;
+		}
+		if(j < max){
+			out[j] = CritSites[i];
+		}
+	}
+	EndCritical(sr);
+	return n;
+}
+
+/** OS_CSClear
+* @brief Reset call site table and per thread wake-to-run stats
+*/
+void OS_CSClear(void){
+	INT32U i;
+	INT32U sr = StartCritical();
+	for(i = 0; i < CS_SITES; i++){
+		CritSites[i].site = 0;
+		CritSites[i].count = 0;
+		CritSites[i].maxCycles = 0;
+		CritSites[i].totalCycles = 0;
+	}
+	OS_WakeClear();
+	EndCritical(sr);
+}
+
+#endif
@@ -0,0 +1,438 @@
+/**
+* @file OSQueue.c
+* @brief Message queues for OS, any number of channels instead of the one OS Fifo
+* 
+*/
+#include <string.h>
+#include "startup.h"
+#include "OS.h"
+
+
+/*! @var QueueType Queues
+    @brief Control blocks for queues, item storage is owned by the caller
+*/
+static QueueType Queues[NUMQUEUES];
+
+/*! @var INT32U NumOfQueues
+    @brief number of queues created
+*/
+static INT32U NumOfQueues = 0;
+
+
+/** QueueWrite
+ *	@brief copy items into free slots, slots must already be reserved on Empty
+ *			only the index move is done with interrupts off, the copy (at most two
+ *			memcpy, one up to the end of buffer and one after the wrap) runs with
+ *			them on. Full is signaled once no other producer is still copying so
+ *			a consumer never reads a reserved slot before it is filled
+ *  @param queue queue handle
+ *  @param items data to copy in
+ *  @param n number of items
+*/
+static void QueueWrite(QueueType *queue, const void *items, INT32U n){
+	const INT8U *src = (const INT8U*)items;
+	INT32U idx, first;
+	INT32U publish = 0;
+	// reserve slots, two producers cant get the same ones
+	INT32U sr = StartCritical();
+	idx = queue->putIdx;
+	queue->putIdx += n;
+	if(queue->putIdx >= queue->depth){
+		queue->putIdx -= queue->depth;
+	}
+	queue->putBusy++;
+	EndCritical(sr);
+	
+	first = queue->depth - idx;
+	if(first > n){
+		first = n;
+	}
+	memcpy(&queue->buffer[idx*queue->itemSize], src, first*queue->itemSize);
+	memcpy(queue->buffer, &src[first*queue->itemSize], (n - first)*queue->itemSize);
+	
+	// last producer out publishes everything copied so far
+	sr = StartCritical();
+	queue->putDone += n;
+	if(--queue->putBusy == 0){
+		publish = queue->putDone;
+		queue->putDone = 0;
+		queue->count += publish;
+	}
+	EndCritical(sr);
+	if(publish){
+		OS_SignalN(&queue->Full, publish);
+	}
+}
+
+/** QueueRead
+ *	@brief copy items out of queue, items must already be reserved on Full
+ *			same as QueueWrite, copy runs with interrupts on and slots go back
+ *			to Empty once no other consumer is still copying out
+ *  @param queue queue handle
+ *  @param items where to copy data
+ *  @param n number of items
+*/
+static void QueueRead(QueueType *queue, void *items, INT32U n){
+	INT8U *dst = (INT8U*)items;
+	INT32U idx, first;
+	INT32U release = 0;
+	INT32U sr = StartCritical();
+	idx = queue->getIdx;
+	queue->getIdx += n;
+	if(queue->getIdx >= queue->depth){
+		queue->getIdx -= queue->depth;
+	}
+	queue->count -= n;
+	queue->getBusy++;
+	EndCritical(sr);
+	
+	first = queue->depth - idx;
+	if(first > n){
+		first = n;
+	}
+	memcpy(dst, &queue->buffer[idx*queue->itemSize], first*queue->itemSize);
+	memcpy(&dst[first*queue->itemSize], queue->buffer, (n - first)*queue->itemSize);
+	
+	sr = StartCritical();
+	queue->getDone += n;
+	if(--queue->getBusy == 0){
+		release = queue->getDone;
+		queue->getDone = 0;
+	}
+	EndCritical(sr);
+	if(release){
+		OS_SignalN(&queue->Empty, release);
+	}
+}
+
+/** QueueDrop
+ *	@brief count items that could not be put
+ *  @param queue queue handle
+ *  @param n number of items lost
+*/
+static void QueueDrop(QueueType *queue, INT32U n){
+	INT32U sr = StartCritical();
+	queue->dropped += n;
+	EndCritical(sr);
+}
+
+/** OS_QueueInit
+ *	@brief set queue to empty and attach storage, caller owns control block
+ *  @param queue queue to init
+ *  @param buf caller storage
+ *  @param itemSize size of item in bytes
+ *  @param depth max number of items
+*/
+void OS_QueueInit(QueueType *queue, void *buf, INT32U itemSize, INT32U depth){
+	queue->buffer = (INT8U*)buf;
+	queue->itemSize = itemSize;
+	queue->depth = depth;
+	queue->putIdx = queue->getIdx = 0;
+	queue->count = 0;
+	queue->dropped = 0;
+	queue->putBusy = queue->putDone = 0;
+	queue->getBusy = queue->getDone = 0;
+	OS_InitSemaphore(&queue->Full, 0);
+	OS_InitSemaphore(&queue->Empty, depth);
+}
+
+/** OS_QueueCreate
+* @brief Grab a free queue control block and attach caller storage
+* @param buf storage for depth*itemSize bytes
+* @param itemSize size of item in bytes
+* @param depth max number of items
+* @return queue handle, 0 if fail
+*/
+QueueType* OS_QueueCreate(void *buf, INT32U itemSize, INT32U depth){
+	QueueType *queue;
+	if(buf == 0 || itemSize == 0 || depth == 0){
+		return 0;
+	}
+	INT32U sr = StartCritical();
+	// out of control blocks, bump NUMQUEUES
+	if(NumOfQueues >= NUMQUEUES){
+		EndCritical(sr);
+		return 0;
+	}
+	queue = &Queues[NumOfQueues++];
+	EndCritical(sr);
+	
+	OS_QueueInit(queue, buf, itemSize, depth);
+	return queue;
+}
+
+/** OS_QueuePut
+* @brief Copy item to queue, block on Empty until there is a free slot
+* @param queue queue handle
+* @param item data to copy in
+*/
+void OS_QueuePut(QueueType *queue, const void *item){
+	OS_Wait(&queue->Empty);
+	QueueWrite(queue, item, 1);
+}
+
+/** OS_QueuePutN
+* @brief Copy block of items to queue, waits once per batch of free slots instead of per item
+* @param queue queue handle
+* @param items data to copy in
+* @param n number of items
+*/
+void OS_QueuePutN(QueueType *queue, const void *items, INT32U n){
+	const INT8U *src = (const INT8U*)items;
+	INT32U batch;
+	while(n > 0){
+		// block for one slot then grab whatever else is free
+		OS_Wait(&queue->Empty);
+		batch = 1 + OS_TryWaitN(&queue->Empty, n - 1);
+		QueueWrite(queue, src, batch);
+		src += batch*queue->itemSize;
+		n -= batch;
+	}
+}
+
+/** OS_QueueTryPutN
+* @brief Copy as many items as fit, never blocks so ISRs can use it
+* @param queue queue handle
+* @param items data to copy in
+* @param n number of items
+* @return number of items put, the rest are counted as dropped
+*/
+INT32U OS_QueueTryPutN(QueueType *queue, const void *items, INT32U n){
+	INT32U batch = OS_TryWaitN(&queue->Empty, n);
+	if(batch > 0){
+		QueueWrite(queue, items, batch);
+	}
+	if(batch < n){
+		QueueDrop(queue, n - batch);
+	}
+	return batch;
+}
+
+/** OS_QueuePutTimeout
+* @brief Copy item to queue, producer parks on Empty while full, gives up after timeout
+* @param queue queue handle
+* @param item data to copy in
+* @param timeout max time to block (ms)
+* @return 1 if put, 0 if timed out
+*/
+INT8 OS_QueuePutTimeout(QueueType *queue, const void *item, INT32U timeout){
+	if(OS_WaitTimeout(&queue->Empty, timeout) == 0){
+		QueueDrop(queue, 1);
+		return 0;
+	}
+	QueueWrite(queue, item, 1);
+	return 1;
+}
+
+/** OS_QueueTryPut
+* @brief Copy item to queue if slot free, never blocks so ISRs can use it
+* @param queue queue handle
+* @param item data to copy in
+* @return 1 if put, 0 if full
+*/
+INT8 OS_QueueTryPut(QueueType *queue, const void *item){
+	if(OS_TryWait(&queue->Empty) == 0){
+		QueueDrop(queue, 1);
+		return 0;
+	}
+	QueueWrite(queue, item, 1);
+	return 1;
+}
+
+/** OS_QueueGet
+* @brief Copy item out of queue, block on Full until there is data
+* @param queue queue handle
+* @param item where to copy data
+*/
+void OS_QueueGet(QueueType *queue, void *item){
+	OS_Wait(&queue->Full);
+	QueueRead(queue, item, 1);
+}
+
+/** OS_QueueGetN
+* @brief Copy up to n items out of queue, blocks only until there is at least one
+* @param queue queue handle
+* @param items where to copy data
+* @param n max number of items
+* @return number of items copied
+*/
+INT32U OS_QueueGetN(QueueType *queue, void *items, INT32U n){
+	INT32U batch;
+	if(n == 0){
+		return 0;
+	}
+	OS_Wait(&queue->Full);
+	batch = 1 + OS_TryWaitN(&queue->Full, n - 1);
+	QueueRead(queue, items, batch);
+	return batch;
+}
+
+/** OS_QueueSize
+* @brief Number of items in queue, semaphore value cant be used since it goes negative
+* @param queue queue handle
+* @return items in queue
+*/
+INT32U OS_QueueSize(QueueType *queue){
+	return queue->count;
+}
+
+/** OS_QueueDropped
+* @brief Number of items lost because queue was full
+* @param queue queue handle
+* @return dropped count
+*/
+INT32U OS_QueueDropped(QueueType *queue){
+	return queue->dropped;
+}
+
+/** PriQueueWrite
+ *	@brief take free slot, copy item in and link it into its priority bucket, slot reserved on Empty
+ *  @param queue priority queue
+ *  @param item data to copy in
+ *  @param priority bucket
+ *  @param front 1 to link at head of bucket instead of tail
+*/
+static void PriQueueWrite(PriQueueType *queue, const void *item, INT32U priority, INT8U front){
+	void **slot;
+	if(priority >= PRIORITYLEVELS){
+		priority = PRIORITYLEVELS - 1;
+	}
+	INT32U sr = StartCritical();
+	// slot is [next ptr][item]
+	slot = (void**)queue->freeList;
+	queue->freeList = *slot;
+	memcpy(&slot[1], item, queue->itemSize);
+	if(queue->head[priority] == 0){
+		*slot = 0;
+		queue->head[priority] = queue->tail[priority] = slot;
+	}else if(front){
+		*slot = queue->head[priority];
+		queue->head[priority] = slot;
+	}else{
+		*slot = 0;
+		*(void**)queue->tail[priority] = slot;
+		queue->tail[priority] = slot;
+	}
+	queue->count++;
+	EndCritical(sr);
+	OS_Signal(&queue->Full);
+}
+
+/** OS_PriQueueInit
+ *	@brief chain all slots into free list, all buckets empty
+ *  @param queue priority queue
+ *  @param buf caller storage
+ *  @param itemSize size of item in bytes
+ *  @param depth max number of items
+*/
+void OS_PriQueueInit(PriQueueType *queue, void *buf, INT32U itemSize, INT32U depth){
+	INT8U *slot = (INT8U*)buf;
+	queue->buffer = (INT8U*)buf;
+	queue->itemSize = itemSize;
+	queue->slotSize = PRIQUEUE_SLOT_SIZE(itemSize);
+	queue->depth = depth;
+	queue->count = 0;
+	for(INT32U i = 0; i < depth - 1; i++){
+		*(void**)slot = slot + queue->slotSize;
+		slot += queue->slotSize;
+	}
+	*(void**)slot = 0;
+	queue->freeList = buf;
+	for(INT32U pri = 0; pri < PRIORITYLEVELS; pri++){
+		queue->head[pri] = queue->tail[pri] = 0;
+	}
+	OS_InitSemaphore(&queue->Full, 0);
+	OS_InitSemaphore(&queue->Empty, depth);
+}
+
+/** OS_PriQueuePut
+* @brief Copy item to back of its priority bucket, block on Empty while full
+* @param queue priority queue
+* @param item data to copy in
+* @param priority 0 highest
+*/
+void OS_PriQueuePut(PriQueueType *queue, const void *item, INT32U priority){
+	OS_Wait(&queue->Empty);
+	PriQueueWrite(queue, item, priority, 0);
+}
+
+/** OS_PriQueueTryPut
+* @brief Copy item to back of its priority bucket if slot free, never blocks
+* @param queue priority queue
+* @param item data to copy in
+* @param priority 0 highest
+* @return 1 if put, 0 if full
+*/
+INT8 OS_PriQueueTryPut(PriQueueType *queue, const void *item, INT32U priority){
+	if(OS_TryWait(&queue->Empty) == 0){
+		return 0;
+	}
+	PriQueueWrite(queue, item, priority, 0);
+	return 1;
+}
+
+/** OS_PriQueuePutFront
+* @brief Urgent item goes to head of priority 0 bucket, next out no matter what is queued
+* @param queue priority queue
+* @param item data to copy in
+*/
+void OS_PriQueuePutFront(PriQueueType *queue, const void *item){
+	OS_Wait(&queue->Empty);
+	PriQueueWrite(queue, item, 0, 1);
+}
+
+/** OS_PriQueueGet
+* @brief Unlink head of highest non empty bucket, cost depends on PRIORITYLEVELS not on items queued
+* @param queue priority queue
+* @param item where to copy data
+* @return priority of item
+*/
+INT32U OS_PriQueueGet(PriQueueType *queue, void *item){
+	void **slot;
+	INT32U pri;
+	OS_Wait(&queue->Full);
+	INT32U sr = StartCritical();
+	// go through priority list, exit when highest bucket with data found
+	for(pri = 0; pri < PRIORITYLEVELS; pri++){
+		if(queue->head[pri] != 0)
+			break;
+	}
+	slot = (void**)queue->head[pri];
+	queue->head[pri] = *slot;
+	memcpy(item, &slot[1], queue->itemSize);
+	*slot = queue->freeList;
+	queue->freeList = slot;
+	queue->count--;
+	EndCritical(sr);
+	OS_Signal(&queue->Empty);
+	return pri;
+}
+
+/** OS_PriQueueSize
+* @brief Number of items in priority queue
+* @param queue priority queue
+* @return items in queue
+*/
+INT32U OS_PriQueueSize(PriQueueType *queue){
+	return queue->count;
+}
+
+/** OS_MsgSend
+* @brief Pass block by handle, only the pointer goes through the queue
+* @param queue queue of block pointers
+* @param block block to send, ownership goes to receiver
+*/
+void OS_MsgSend(QueueType *queue, void *block){
+	OS_QueuePut(queue, &block);
+}
+
+/** OS_MsgRecv
+* @brief Get block handle sent by OS_MsgSend, blocks if empty
+* @param queue queue of block pointers
+* @return block, receiver must free it to its pool
+*/
+void* OS_MsgRecv(QueueType *queue){
+	void *block;
+	OS_QueueGet(queue, &block);
+	return block;
+}
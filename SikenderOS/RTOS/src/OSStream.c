@@ -0,0 +1,126 @@
+/**
+* @file OSStream.c
+* @brief Byte stream buffers, one writer (ISR or thread) and one reader that sleeps until enough bytes arrive
+* 
+*/
+#include <string.h>
+#include "startup.h"
+#include "OS.h"
+
+
+/** OS_StreamInit
+* @brief Attach storage, stream starts empty
+* @param stream stream
+* @param buf storage
+* @param size bytes of storage, power of 2
+* @param trigger default bytes needed to wake reader
+*/
+void OS_StreamInit(StreamType *stream, void *buf, INT32U size, INT32U trigger){
+	INT32U sr = StartCritical();
+	stream->buffer = (INT8U*)buf;
+	stream->size = size;
+	stream->putIdx = stream->getIdx = 0;
+	stream->trigger = (trigger == 0) ? 1 : trigger;
+	stream->waitLevel = 0;
+	OS_InitSemaphore(&stream->DataReady, 0);
+	EndCritical(sr);
+}
+
+/** OS_StreamAvailable
+* @brief bytes waiting to be read
+* @param stream stream
+* @return bytes available
+*/
+INT32U OS_StreamAvailable(StreamType *stream){
+	return stream->putIdx - stream->getIdx;
+}
+
+/** OS_StreamSpace
+* @brief bytes that can still be written
+* @param stream stream
+* @return free bytes
+*/
+INT32U OS_StreamSpace(StreamType *stream){
+	return stream->size - (stream->putIdx - stream->getIdx);
+}
+
+/** OS_StreamWrite
+* @brief Copy bytes in with at most two memcpy, wake reader once its level is reached
+* @param stream stream
+* @param data bytes to write
+* @param n number of bytes
+* @return bytes written
+*/
+INT32U OS_StreamWrite(StreamType *stream, const void *data, INT32U n){
+	const INT8U *src = (const INT8U*)data;
+	INT32U space = OS_StreamSpace(stream);
+	INT32U idx = stream->putIdx & (stream->size - 1);
+	INT32U first;
+	if(n > space){
+		n = space;
+	}
+	first = stream->size - idx;
+	if(first > n){
+		first = n;
+	}
+	memcpy(&stream->buffer[idx], src, first);
+	memcpy(stream->buffer, &src[first], n - first);
+	
+	INT32U sr = StartCritical();
+	stream->putIdx += n;
+	// wake reader only when it has enough to do its work
+	if(stream->waitLevel && (OS_StreamAvailable(stream) >= stream->waitLevel)){
+		stream->waitLevel = 0;
+		OS_Signal(&stream->DataReady);
+	}
+	EndCritical(sr);
+	return n;
+}
+
+/** OS_StreamRead
+* @brief Block until minBytes (or trigger level) are in stream, then copy out up to max bytes
+* @param stream stream
+* @param data where to copy bytes
+* @param max max bytes to read
+* @param minBytes bytes to wait for, 0 uses trigger
+* @param timeout max time to block (ms)
+* @return bytes read
+*/
+INT32U OS_StreamRead(StreamType *stream, void *data, INT32U max, INT32U minBytes, INT32U timeout){
+	INT8U *dst = (INT8U*)data;
+	INT32U avail, idx, first;
+	if(minBytes == 0){
+		minBytes = stream->trigger;
+	}
+	if(minBytes > max){
+		minBytes = max;
+	}
+	
+	INT32U sr = StartCritical();
+	if(OS_StreamAvailable(stream) < minBytes){
+		stream->waitLevel = minBytes;
+		EndCritical(sr);
+		OS_WaitTimeout(&stream->DataReady, timeout);
+		sr = StartCritical();
+		// timed out, drop signal that may have come in after
+		stream->waitLevel = 0;
+		if(stream->DataReady.Value > 0){
+			stream->DataReady.Value = 0;
+		}
+	}
+	EndCritical(sr);
+	
+	avail = OS_StreamAvailable(stream);
+	if(avail > max){
+		avail = max;
+	}
+	idx = stream->getIdx & (stream->size - 1);
+	first = stream->size - idx;
+	if(first > avail){
+		first = avail;
+	}
+	memcpy(dst, &stream->buffer[idx], first);
+	memcpy(&dst[first], stream->buffer, avail - first);
+	stream->getIdx += avail;
+	return avail;
+}
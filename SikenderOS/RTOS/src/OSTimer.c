@@ -0,0 +1,243 @@
+/**
+* @file OSTimer.c
+* @brief Hierarchical timing wheel, runs software timers, sleeps and semaphore timeouts
+* 
+* Driven by 1 ms Timer0A tick (OS_SleepHandler). Level 0 has one slot per tick,
+* each higher level slot covers a whole lap of the level below. Timer goes in the
+* level its delay fits in and is moved down (cascaded) when the lower level gets
+* to it, so add, remove and expire are O(1) no matter how many timers are armed.
+* Software timer callbacks are handed to the deferred work thread (OSDefer.c), sleeps,
+* timeouts and wheel periodic threads still expire in the tick ISR.
+*/
+#include "startup.h"
+#include "OS.h"
+
+
+#define WHEEL_BITS		6							// 64 slots per level
+#define WHEEL_SLOTS		(1U << WHEEL_BITS)
+#define WHEEL_MASK		(WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS	4							// 2^24 ticks (4.6 hours) before parking in top level
+
+static INT32U WheelNow;		// last tick processed
+static TimerType *Wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+
+
+/** SlotLink
+* @brief Push timer on front of slot list
+* @param head slot list
+* @param timer timer
+*/
+static void SlotLink(TimerType **head, TimerType *timer){
+	timer->next = *head;
+	if(*head){
+		(*head)->pprev = &timer->next;
+	}
+	*head = timer;
+	timer->pprev = head;
+}
+
+/** WheelInsert
+* @brief Put timer in slot for its expire, interrupts off
+* @param timer timer with expire set, expire - WheelNow >= 0
+*/
+static void WheelInsert(TimerType *timer){
+	INT32U delta = timer->expire - WheelNow;
+	INT32U level = 0;
+	INT32U slot;
+	while(level < WHEEL_LEVELS - 1 && delta >= (WHEEL_SLOTS << (level*WHEEL_BITS))){
+		level++;
+	}
+	if(delta >= (WHEEL_SLOTS << (level*WHEEL_BITS))){
+		// too far out, park in current top slot, next cascade of it is a lap away
+		slot = (WheelNow >> (level*WHEEL_BITS)) & WHEEL_MASK;
+	}else{
+		slot = (timer->expire >> (level*WHEEL_BITS)) & WHEEL_MASK;
+	}
+	SlotLink(&Wheel[level][slot], timer);
+	timer->active = 1;
+}
+
+/** OS_TickCount
+* @brief Ticks (ms) wheel has processed since OS_Init, never cleared
+* @return tick count, wraps after 49 days
+*/
+INT32U OS_TickCount(void){
+	return WheelNow;
+}
+
+/** OS_WheelAdd
+* @brief Arm timer to expire ticks from now, kernel use, interrupts off
+* @param timer timer with expireFn set, must not be armed
+* @param ticks delay, at least 1
+*/
+void OS_WheelAdd(TimerType *timer, INT32U ticks){
+	timer->expire = WheelNow + ((ticks == 0) ? 1 : ticks);
+	WheelInsert(timer);
+}
+
+/** OS_WheelRemove
+* @brief Disarm timer, O(1), nothing happens if not armed, kernel use, interrupts off
+* @param timer timer
+*/
+void OS_WheelRemove(TimerType *timer){
+	if(!timer->active){
+		return;
+	}
+	*timer->pprev = timer->next;
+	if(timer->next){
+		timer->next->pprev = timer->pprev;
+	}
+	timer->active = 0;
+}
+
+/** SlotDetach
+* @brief Move whole slot list to local head so callbacks that rearm into same slot are not rerun
+* @param head local head
+* @param slot slot list
+*/
+static void SlotDetach(TimerType **head, TimerType **slot){
+	*head = *slot;
+	*slot = 0;
+	if(*head){
+		(*head)->pprev = head;
+	}
+}
+
+/** OS_WheelTick
+* @brief Advance wheel one tick, cascade higher levels and expire due timers, called from tick ISR
+*/
+void OS_WheelTick(void){
+	TimerType *pending;
+	TimerType *timer;
+	INT32U level;
+	INT32U sr = StartCritical();
+	WheelNow++;
+	// find highest level that wrapped, cascade top down so entries can fall through
+	level = 0;
+	while(level < WHEEL_LEVELS - 1 && (WheelNow & ((1U << ((level + 1)*WHEEL_BITS)) - 1)) == 0){
+		level++;
+	}
+	for(; level > 0; level--){
+		SlotDetach(&pending, &Wheel[level][(WheelNow >> (level*WHEEL_BITS)) & WHEEL_MASK]);
+		while(pending){
+			timer = pending;
+			OS_WheelRemove(timer);
+			WheelInsert(timer);
+		}
+	}
+	SlotDetach(&pending, &Wheel[0][WheelNow & WHEEL_MASK]);
+	EndCritical(sr);
+	// everything in pending expires now, callbacks run with interrupts on
+	for(;;){
+		sr = StartCritical();
+		timer = pending;
+		if(timer){
+			OS_WheelRemove(timer);
+		}
+		EndCritical(sr);
+		if(timer == 0){
+			break;
+		}
+		timer->expireFn(timer);
+	}
+}
+
+/** UserTimerCallback
+* @brief Run software timer callback from deferred work thread
+* @param timer timer
+*/
+static void UserTimerCallback(void *timer){
+	((TimerType*)timer)->callback();
+}
+
+/** UserTimerExpire
+* @brief Wheel expire hook for OS_Timer* timers, periodic ones are rearmed first
+*	so callback can stop or change itself, callback is deferred out of tick ISR
+* @param timer timer
+*/
+static void UserTimerExpire(TimerType *timer){
+	INT32U sr;
+	if(timer->periodic){
+		sr = StartCritical();
+		if(!timer->active){
+			// from last expire not now so period does not drift
+			timer->expire += timer->period;
+			WheelInsert(timer);
+		}
+		EndCritical(sr);
+	}
+	OS_Defer(&UserTimerCallback, timer);
+}
+
+/** OS_TimerServiceInit
+* @brief Empty the wheel, called by OS_Init
+*/
+void OS_TimerServiceInit(void){
+	WheelNow = 0;
+	for(INT32U level = 0; level < WHEEL_LEVELS; level++){
+		for(INT32U slot = 0; slot < WHEEL_SLOTS; slot++){
+			Wheel[level][slot] = 0;
+		}
+	}
+}
+
+/** OS_TimerCreate
+* @brief Setup timer, timer starts stopped
+* @param timer caller storage, must live while timer is used
+* @param callback function run by deferred work thread on expire
+* @param period ms between expires, also first delay
+* @param periodic 1 rearm after every expire, 0 one-shot
+*/
+void OS_TimerCreate(TimerType *timer, void(*callback)(void), INT32U period, INT8U periodic){
+	timer->callback = callback;
+	timer->expireFn = &UserTimerExpire;
+	timer->period = (period == 0) ? 1 : period;
+	timer->periodic = periodic;
+	timer->active = 0;
+	timer->next = 0;
+}
+
+/** OS_TimerStart
+* @brief Arm timer to expire one period from now, restarts if already armed
+* @param timer timer
+*/
+void OS_TimerStart(TimerType *timer){
+	INT32U sr = StartCritical();
+	OS_WheelRemove(timer);
+	OS_WheelAdd(timer, timer->period);
+	EndCritical(sr);
+}
+
+/** OS_TimerStop
+* @brief Disarm timer, nothing happens if not armed
+* @param timer timer
+*/
+void OS_TimerStop(TimerType *timer){
+	INT32U sr = StartCritical();
+	OS_WheelRemove(timer);
+	EndCritical(sr);
+}
+
+/** OS_TimerChangePeriod
+* @brief Change period, an armed timer is restarted with new period from now
+* @param timer timer
+* @param period new period in ms
+*/
+void OS_TimerChangePeriod(TimerType *timer, INT32U period){
+	INT32U sr = StartCritical();
+	timer->period = (period == 0) ? 1 : period;
+	if(timer->active){
+		OS_WheelRemove(timer);
+		OS_WheelAdd(timer, timer->period);
+	}
+	EndCritical(sr);
+}
+
+/** OS_TimerIsActive
+* @brief Check if timer is armed
+* @param timer timer
+* @return 1 armed, 0 stopped or one-shot already fired
+*/
+INT8 OS_TimerIsActive(TimerType *timer){
+	return timer->active;
+}
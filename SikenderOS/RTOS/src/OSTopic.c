@@ -0,0 +1,97 @@
+/**
+* @file OSTopic.c
+* @brief Publish/subscribe topics, one write fans out to any number of reader threads
+* 
+*/
+#include <string.h>
+#include "startup.h"
+#include "OS.h"
+
+
+/** OS_TopicInit
+* @brief Attach storage, topic starts with no subscribers
+* @param topic topic
+* @param buf storage for depth*itemSize bytes
+* @param itemSize size of item in bytes
+* @param depth number of items kept, must be power of 2 so cursors can wrap
+*/
+void OS_TopicInit(TopicType *topic, void *buf, INT32U itemSize, INT32U depth){
+	INT32U sr = StartCritical();
+	topic->buffer = (INT8U*)buf;
+	topic->itemSize = itemSize;
+	topic->depth = depth;
+	topic->published = 0;
+	topic->subscribers = 0;
+	EndCritical(sr);
+}
+
+/** OS_TopicSubscribe
+* @brief Add reader to head of topic LL, cursor starts at newest item
+* @param topic topic
+* @param sub subscriber
+*/
+void OS_TopicSubscribe(TopicType *topic, SubscriberType *sub){
+	OS_InitSemaphore(&sub->NewData, 0);
+	INT32U sr = StartCritical();
+	sub->topic = topic;
+	sub->readCount = topic->published;
+	sub->overruns = 0;
+	sub->next = topic->subscribers;
+	topic->subscribers = sub;
+	EndCritical(sr);
+}
+
+/** OS_TopicPublish
+* @brief Copy item into ring once, wake any subscriber waiting on new data
+* @param topic topic
+* @param item item to publish
+*/
+void OS_TopicPublish(TopicType *topic, const void *item){
+	SubscriberType *sub;
+	INT32U sr = StartCritical();
+	memcpy(&topic->buffer[(topic->published & (topic->depth-1))*topic->itemSize], item, topic->itemSize);
+	topic->published++;
+	// signal once, reader catches up on everything it missed
+	for(sub = topic->subscribers; sub != 0; sub = sub->next){
+		if(sub->NewData.Value < 1){
+			OS_Signal(&sub->NewData);
+		}
+	}
+	EndCritical(sr);
+}
+
+/** OS_TopicRead
+* @brief Copy next unread item for this subscriber, skip ahead if publisher lapped it
+* @param sub subscriber
+* @param item where to copy item
+* @return 1 if item read, 0 if nothing new
+*/
+INT8 OS_TopicRead(SubscriberType *sub, void *item){
+	TopicType *topic = sub->topic;
+	INT32U sr = StartCritical();
+	INT32U behind = topic->published - sub->readCount;
+	if(behind == 0){
+		EndCritical(sr);
+		return 0;
+	}
+	// oldest items already overwritten, count them and jump to oldest kept
+	if(behind > topic->depth){
+		sub->overruns += behind - topic->depth;
+		sub->readCount = topic->published - topic->depth;
+	}
+	memcpy(item, &topic->buffer[(sub->readCount & (topic->depth-1))*topic->itemSize], topic->itemSize);
+	sub->readCount++;
+	EndCritical(sr);
+	return 1;
+}
+
+/** OS_TopicReceive
+* @brief Blocking read, waits on subscriber semaphore until publisher has new data
+* @param sub subscriber
+* @param item where to copy item
+*/
+void OS_TopicReceive(SubscriberType *sub, void *item){
+	while(OS_TopicRead(sub, item) == 0){
+		OS_Wait(&sub->NewData);
+	}
+}
@@ -0,0 +1,65 @@
+/**
+* @file OSTrace.c
+* @brief Binary event trace, fixed size ring in RAM, compiled in with OS_TRACE
+* 
+* Each event is two words, DWT cycle timestamp and type/id/arg. Slot is claimed with
+* LDREX/STREX so threads and nested ISRs can record without locking. Ring keeps the
+* newest TRACE_SIZE events, dump OS_TraceLog from debugger or "os -trace" and
+* decode with tools/trace2chrome.py.
+*/
+#include "cpu.h"
+#include "OS.h"
+
+#if OS_TRACE
+
+/*! @var TraceLogType OS_TraceLog
+    @brief trace ring, global so debugger can dump it by symbol
+*/
+TraceLogType OS_TraceLog;
+
+
+/** OS_TraceInit
+* @brief Empty trace ring, called by OS_Init
+*/
+void OS_TraceInit(void){
+	OS_TraceLog.magic = TRACE_MAGIC;
+	OS_TraceLog.writeIdx = 0;
+	OS_TraceLog.size = TRACE_SIZE;
+	OS_TraceLog.busClock = BUS_CLK;
+}
+
+/** OS_TraceEvent
+* @brief Record event, lock free, safe from threads and ISRs
+* @param type TRACE_SWITCH, TRACE_BLOCK, ...
+* @param id thread id or exception number, 8 bits
+* @param arg event data, 16 bits
+*/
+void OS_TraceEvent(INT32U type, INT32U id, INT32U arg){
+	INT32U idx;
+	TraceEventType *event;
+	do{
+		idx = OS_TraceLog.writeIdx;
+	}while(!OS_ASM_CompareSwap(&OS_TraceLog.writeIdx, idx, idx + 1));
+	event = &OS_TraceLog.events[idx & (TRACE_SIZE - 1)];
+	event->time = OS_Time();
+	event->info = (type << 24) | ((id & 0xFF) << 16) | (arg & 0xFFFF);
+}
+
+/** OS_TraceClock
+* @brief Mark bus clock change, timestamps are OS_Time so their rate stays BUS_CLK
+* @param oldClock clock before change (Hz)
+* @param newClock clock after change (Hz)
+*/
+void OS_TraceClock(INT32U oldClock, INT32U newClock){
+	OS_TraceEvent(TRACE_CLOCK, newClock/1000000, (oldClock + 5000)/10000);
+}
+
+/** OS_TraceContext
+* @brief Id to tag FIFO events with
+* @return current thread id, TRACE_ID_ISR if in ISR
+*/
+INT32U OS_TraceContext(void){
+	return OS_ASM_IPSR() ? TRACE_ID_ISR : OS_IdThread();
+}
+
+#endif
@@ -0,0 +1,92 @@
+/**
+* @file OSWork.c
+* @brief Worker thread pool, NUMWORKERS threads made once at OS_Init take jobs
+*	(function plus argument) from a priority queue
+*
+* Short lived work (one-shot handlers, blocking I/O) goes here instead of OS_AddThread
+* and OS_Kill per event, so bursts cost a queue put, not a stack setup and TCB search,
+* and only drop when JOB_DEPTH jobs are already waiting. Jobs may sleep or block,
+* that worker is busy meanwhile and the other workers keep going. Fixed delays
+* (like switch debounce) should use a one-shot OS_TimerCreate timer instead so
+* no worker is held sleeping.
+*/
+#include "startup.h"
+#include "OS.h"
+
+
+/*! @var PriQueueType JobQueue
+    @brief jobs waiting for a worker, job priority picks bucket
+*/
+static PriQueueType JobQueue;
+
+/*! @var INT32U JobBuffer
+    @brief slot storage for JobQueue
+*/
+static INT32U JobBuffer[JOB_DEPTH*PRIQUEUE_SLOT_SIZE(sizeof(WorkType))/sizeof(INT32U)];
+
+/*! @var INT32U JobsDropped
+    @brief jobs lost because queue was full, only changed with OS_ASM_CompareSwap
+*/
+static volatile INT32U JobsDropped;
+
+
+/** Worker
+* @brief Pool thread, runs highest priority job waiting, blocks when none
+*/
+static void Worker(void){
+	WorkType job;
+	while(1){
+		OS_PriQueueGet(&JobQueue, &job);
+		job.fn(job.arg);
+	}
+}
+
+/** OS_WorkPoolInit
+* @brief Empty job queue and add NUMWORKERS worker threads, called by OS_Init
+*/
+void OS_WorkPoolInit(void){
+	OS_PriQueueInit(&JobQueue, JobBuffer, sizeof(WorkType), JOB_DEPTH);
+	JobsDropped = 0;
+	for(INT32U i = 0; i < NUMWORKERS; i++){
+		OS_AddThread(&Worker, WORKER_PRIORITY);
+	}
+}
+
+/** OS_JobSubmit
+* @brief Queue job for worker pool, never blocks, safe from threads and any ISR
+*	at or below OS_MAX_SYSCALL_PRIORITY
+* @param fn function to run
+* @param arg passed to fn
+* @param priority job priority 0 (first out) to PRIORITYLEVELS-1
+* @return 1 queued, 0 queue full (counted as dropped)
+*/
+INT8 OS_JobSubmit(void(*fn)(void *arg), void *arg, INT32U priority){
+	WorkType job;
+	INT32U dropped;
+	job.fn = fn;
+	job.arg = arg;
+	if(OS_PriQueueTryPut(&JobQueue, &job, priority) == 0){
+		// nested ISRs can both drop, count with CAS so neither is lost
+		do{
+			dropped = JobsDropped;
+		}while(!OS_ASM_CompareSwap(&JobsDropped, dropped, dropped + 1));
+		return 0;
+	}
+	return 1;
+}
+
+/** OS_JobsPending
+* @brief Number of jobs waiting for a worker
+* @return jobs queued
+*/
+INT32U OS_JobsPending(void){
+	return OS_PriQueueSize(&JobQueue);
+}
+
+/** OS_JobsDropped
+* @brief Number of jobs OS_JobSubmit could not queue since OS_Init
+* @return dropped count
+*/
+INT32U OS_JobsDropped(void){
+	return JobsDropped;
+}
@@ -0,0 +1,129 @@
+/**
+* @file mpsc_stress.c
+* @brief Host stress test for AddMpscFifo (Project/inc/FIFO.h), pthreads stand in for ISRs
+*
+* PRODUCERS threads put ITEMS tagged values each into a small FIFO while one consumer
+* drains it. Consumer checks every value arrives exactly once and in order per producer.
+* Runs twice, from index 0 and from just below the 32 bit index wrap.
+* OS_ASM_CompareSwap is stubbed with the gcc atomic builtin, the critical section
+* stubs only matter for Fifo_Init which runs before the threads start.
+* Ordering relies on x86 (TSO) like the Cortex-M4 build relies on being single core.
+*
+* Build and run from SikenderOS/:
+*   gcc -O2 -pthread -IProject/inc -IRTOS/inc -IHAL/inc -ICMSIS tools/mpsc_stress.c -o mpsc_stress && ./mpsc_stress
+*/
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FIFO.h"
+
+#define PRODUCERS	4
+#define ITEMS		200000		// per producer, fits in 24 bits of tag
+#define SIZE		64			// small so producers keep hitting full
+#define STALL_S		5			// no item this long means one was lost
+
+// OSAsm.s and startup.s stand ins
+INT32U OS_ASM_CompareSwap(volatile INT32U *addr, INT32U expected, INT32U desired){
+	return __atomic_compare_exchange_n(addr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+INT32U StartCritical(void){ return 0; }
+void EndCritical(INT32U sr){ (void)sr; }
+
+AddMpscFifo(Test, SIZE, INT32U, 1, 0)
+
+static volatile int Go;
+
+
+/** Producer
+* @brief Put ITEMS values (producer << 24 | sequence), spin while full
+* @param arg producer number
+*/
+static void *Producer(void *arg){
+	INT32U id = (INT32U)(long)arg;
+	while(!Go){
+		sched_yield();
+	}
+	for(INT32U n = 0; n < ITEMS; n++){
+		while(TestFifo_Put((id << 24) | n) == 0){
+			sched_yield();
+		}
+	}
+	return 0;
+}
+
+/** Run
+* @brief One full stress run with indexes starting at base
+* @param base first index, multiple of SIZE
+* @return number of errors
+*/
+static int Run(INT32U base){
+	pthread_t threads[PRODUCERS];
+	INT32U next[PRODUCERS] = {0};
+	INT32U got = 0;
+	INT32U value;
+	int errors = 0;
+	time_t lastItem;
+
+	TestFifo_Init();
+	// move start of ring, same state Init leaves just shifted by base
+	TestPutI = TestGetI = base;
+	for(INT32U i = 0; i < SIZE; i++){
+		TestSeq[i] = base + i;
+	}
+	Go = 0;
+	for(long p = 0; p < PRODUCERS; p++){
+		pthread_create(&threads[p], 0, &Producer, (void*)p);
+	}
+	Go = 1;
+	lastItem = time(0);
+	while(got < PRODUCERS*ITEMS){
+		if(TestFifo_Get(&value) == 0){
+			if(time(0) - lastItem > STALL_S){
+				// a slot was never published, producers may still be spinning so just quit
+				printf("base 0x%08x: stalled after %u items\nFAIL\n", base, got);
+				exit(1);
+			}
+			sched_yield();		// let producer that reserved the slot finish
+			continue;
+		}
+		lastItem = time(0);
+		got++;
+		INT32U id = value >> 24;
+		INT32U n = value & 0xFFFFFF;
+		if(id >= PRODUCERS){
+			printf("  bad producer %u\n", id);
+			errors++;
+		}else if(n != next[id]){
+			// lost (n ahead) or duplicated/reordered (n behind)
+			if(errors < 10){
+				printf("  producer %u: got %u expected %u\n", id, n, next[id]);
+			}
+			errors++;
+			next[id] = n + 1;
+		}else{
+			next[id]++;
+		}
+	}
+	for(int p = 0; p < PRODUCERS; p++){
+		pthread_join(threads[p], 0);
+	}
+	if(TestFifo_Get(&value) != 0){
+		printf("  extra item after all expected\n");
+		errors++;
+	}
+	if(TestPutI != base + PRODUCERS*ITEMS || TestGetI != base + PRODUCERS*ITEMS){
+		printf("  indexes off: put %u get %u\n", TestPutI, TestGetI);
+		errors++;
+	}
+	printf("base 0x%08x: %u items, %d errors\n", base, got, errors);
+	return errors;
+}
+
+int main(void){
+	int errors = Run(0);
+	errors += Run(0u - SIZE*4);		// crosses 0xFFFFFFFF -> 0
+	printf(errors ? "FAIL\n" : "PASS\n");
+	return errors != 0;
+}
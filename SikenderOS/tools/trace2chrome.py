@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""Convert a SikendeRTOS trace dump to Chrome trace JSON (chrome://tracing, Perfetto).
+
+Input is either
+  - raw binary dump of OS_TraceLog (little endian, e.g. Keil "SAVE" of the symbol), or
+  - text from the interpreter "os -trace" command (hex words between TRACE and END).
+
+Usage: trace2chrome.py dump.bin|dump.txt [-o trace.json] [--mhz 80]
+"""
+import argparse
+import json
+import re
+import struct
+import sys
+
+TRACE_MAGIC = 0x54524345
+HEADER_WORDS = 4
+
+# must match TRACE_* in OS.h
+TRACE_SWITCH = 1
+TRACE_BLOCK = 2
+TRACE_UNBLOCK = 3
+TRACE_TIMEOUT = 4
+TRACE_ISR_ENTER = 5
+TRACE_ISR_EXIT = 6
+TRACE_FIFO_PUT = 7
+TRACE_FIFO_GET = 8
+TRACE_USER = 9
+TRACE_CLOCK = 10
+TRACE_PERIODIC_START = 11
+TRACE_PERIODIC_END = 12
+TRACE_ID_ISR = 0xFF
+
+INSTANT_NAMES = {
+    TRACE_BLOCK: "block",
+    TRACE_UNBLOCK: "unblock",
+    TRACE_TIMEOUT: "timeout",
+    TRACE_FIFO_PUT: "fifo put",
+    TRACE_FIFO_GET: "fifo get",
+    TRACE_USER: "user",
+}
+
+ISR_TID_BASE = 1000
+PERIODIC_TID_BASE = 2000
+
+
+def read_words(path):
+    data = open(path, "rb").read()
+    if data[:5] == b"TRACE" or re.match(rb"\s*[0-9a-fA-F]{8}\s", data):
+        words = []
+        for line in data.decode("ascii", "replace").splitlines():
+            line = line.strip()
+            if line in ("TRACE", "END") or not line:
+                continue
+            words.extend(int(w, 16) for w in line.split())
+        return words
+    return list(struct.unpack("<%dI" % (len(data) // 4), data[: len(data) // 4 * 4]))
+
+
+def decode(words):
+    magic, write_idx, size, bus_clock = words[:HEADER_WORDS]
+    if magic != TRACE_MAGIC:
+        sys.exit("not a trace dump (magic %08x)" % magic)
+    body = words[HEADER_WORDS : HEADER_WORDS + 2 * size]
+    count = min(write_idx, size)
+    first = write_idx - count
+    events = []
+    for n in range(first, write_idx):
+        i = n % size
+        time, info = body[2 * i], body[2 * i + 1]
+        events.append((time, info >> 24, (info >> 16) & 0xFF, info & 0xFFFF))
+    # timestamps are 32 bit cycles, unwrap in record order then sort
+    # (an ISR can record between another event's slot claim and timestamp)
+    out = []
+    base = 0
+    last = None
+    for time, kind, ident, arg in events:
+        if last is not None and time < last and last - time > 0x80000000:
+            base += 1 << 32
+        last = time
+        out.append((base + time, kind, ident, arg))
+    out.sort(key=lambda e: e[0])
+    return out, bus_clock, write_idx - count
+
+
+def event_times(events, bus_clock, mhz=None):
+    """Microseconds since first event. Timestamps are OS_Time, counted at the header
+    clock (BUS_CLK) even across bus clock changes. --mhz overrides."""
+    rate = mhz if mhz else bus_clock / 1e6
+    first = events[0][0] if events else 0
+    return [(time - first) / rate for time, kind, ident, arg in events]
+
+
+def to_chrome(events, times):
+    trace = []
+    names = set()
+    running = None
+
+    def thread_name(tid, name):
+        if tid not in names:
+            names.add(tid)
+            trace.append({"ph": "M", "name": "thread_name", "pid": 0, "tid": tid, "args": {"name": name}})
+
+    for (time, kind, ident, arg), ts in zip(events, times):
+        if kind == TRACE_SWITCH:
+            old = running if running is not None else arg
+            thread_name(old, "thread %d" % old)
+            thread_name(ident, "thread %d" % ident)
+            if running is not None:
+                trace.append({"ph": "E", "pid": 0, "tid": old, "ts": ts})
+            trace.append({"ph": "B", "pid": 0, "tid": ident, "ts": ts, "name": "run"})
+            running = ident
+        elif kind in (TRACE_ISR_ENTER, TRACE_ISR_EXIT):
+            tid = ISR_TID_BASE + ident
+            label = "IRQ %d" % (ident - 16) if ident >= 16 else "exception %d" % ident
+            thread_name(tid, label)
+            ph = "B" if kind == TRACE_ISR_ENTER else "E"
+            ev = {"ph": ph, "pid": 0, "tid": tid, "ts": ts}
+            if ph == "B":
+                ev["name"] = label
+            trace.append(ev)
+        elif kind in (TRACE_PERIODIC_START, TRACE_PERIODIC_END):
+            # own track so it nests visually inside the timer ISR without ending its slice
+            tid = PERIODIC_TID_BASE + ident
+            label = "periodic %d" % ident
+            thread_name(tid, label)
+            ev = {"ph": "B" if kind == TRACE_PERIODIC_START else "E", "pid": 0, "tid": tid, "ts": ts}
+            if kind == TRACE_PERIODIC_START:
+                ev["name"] = label
+            trace.append(ev)
+        elif kind in INSTANT_NAMES:
+            tid = ISR_TID_BASE if ident == TRACE_ID_ISR else ident
+            thread_name(tid, "ISR" if ident == TRACE_ID_ISR else "thread %d" % ident)
+            args = {"items": arg} if kind in (TRACE_FIFO_PUT, TRACE_FIFO_GET) else {"arg": "0x%04x" % arg}
+            trace.append({"ph": "i", "s": "t", "pid": 0, "tid": tid, "ts": ts, "name": INSTANT_NAMES[kind], "args": args})
+        elif kind == TRACE_CLOCK:
+            trace.append({"ph": "i", "s": "g", "pid": 0, "tid": 0, "ts": ts, "name": "bus clock change",
+                          "args": {"old MHz": arg / 100.0, "new MHz": ident}})
+    if running is not None and events:
+        trace.append({"ph": "E", "pid": 0, "tid": running, "ts": times[-1]})
+    return {"traceEvents": trace, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump")
+    parser.add_argument("-o", "--output", default="-")
+    parser.add_argument("--mhz", type=float, help="timestamp rate, default from header (BUS_CLK)")
+    args = parser.parse_args()
+
+    events, bus_clock, lost = decode(read_words(args.dump))
+    if lost:
+        sys.stderr.write("ring wrapped, oldest %d events lost\n" % lost)
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    json.dump(to_chrome(events, event_times(events, bus_clock, args.mhz)), out)
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()